@@ -19,6 +19,10 @@
 
 #include "ilps28qsw_reg.h"
 
+#if defined(ILPS28QSW_USE_SSSE3) && defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif /* ILPS28QSW_USE_SSSE3 */
+
 /**
   * @defgroup    ILPS28QSW
   * @brief       This file provides a set of functions needed to drive the
@@ -36,6 +40,110 @@
   *
   */
 
+/* driver data, only with ILPS28QSW_PRIV_DATA (see ilps28qsw_priv_t) */
+static ilps28qsw_priv_t *priv_get(const stmdev_ctx_t *ctx)
+{
+#ifdef ILPS28QSW_PRIV_DATA
+  return (ilps28qsw_priv_t *)ctx->priv_data;
+#else
+  (void)ctx;
+
+  return NULL;
+#endif /* ILPS28QSW_PRIV_DATA */
+}
+
+#ifdef ILPS28QSW_BUS_STATS
+static ilps28qsw_bus_stats_t *bus_stats_get(stmdev_ctx_t *ctx)
+{
+  ilps28qsw_priv_t *priv = priv_get(ctx);
+
+  return (priv != NULL) ? priv->stats : NULL;
+}
+
+static void bus_stats_count(ilps28qsw_bus_stats_t *stats, uint8_t rd,
+                            uint8_t reg, uint16_t len, int32_t ret)
+{
+  uint8_t slot;
+
+  if (stats != NULL)
+  {
+    if ((reg >= ILPS28QSW_INTERRUPT_CFG) && (reg <= ILPS28QSW_TEMP_OUT_H))
+    {
+      slot = reg - ILPS28QSW_INTERRUPT_CFG;
+    }
+    else if (reg >= ILPS28QSW_FIFO_DATA_OUT_PRESS_XL)
+    {
+      slot = ILPS28QSW_STATS_FIFO;
+    }
+    else
+    {
+      slot = ILPS28QSW_STATS_OTHER;
+    }
+
+    if (rd != 0U)
+    {
+      stats->rd++;
+      stats->rd_bytes += len;
+      stats->slot_rd[slot]++;
+    }
+    else
+    {
+      stats->wr++;
+      stats->wr_bytes += len;
+      stats->slot_wr[slot]++;
+    }
+
+    if (ret != 0)
+    {
+      stats->err++;
+    }
+  }
+}
+
+static uint32_t bus_stats_start(ilps28qsw_bus_stats_t *stats)
+{
+  return ((stats != NULL) && (stats->cycles != NULL)) ? stats->cycles() : 0U;
+}
+
+static void bus_stats_end(ilps28qsw_bus_stats_t *stats, uint32_t start)
+{
+  uint32_t dt;
+  uint8_t bin = 0U;
+
+  if ((stats != NULL) && (stats->cycles != NULL))
+  {
+    dt = stats->cycles() - start;
+
+    /* log2 by binary search */
+    if (dt >= 0x10000U)
+    {
+      dt >>= 16;
+      bin += 16U;
+    }
+    if (dt >= 0x100U)
+    {
+      dt >>= 8;
+      bin += 8U;
+    }
+    if (dt >= 0x10U)
+    {
+      dt >>= 4;
+      bin += 4U;
+    }
+    if (dt >= 0x4U)
+    {
+      dt >>= 2;
+      bin += 2U;
+    }
+    if (dt >= 0x2U)
+    {
+      bin += 1U;
+    }
+    stats->lat[bin]++;
+  }
+}
+#endif /* ILPS28QSW_BUS_STATS */
+
 /**
   * @brief  Read generic device register
   *
@@ -50,7 +158,17 @@ int32_t __weak ilps28qsw_read_reg(stmdev_ctx_t *ctx, uint8_t reg, uint8_t *data,
                                   uint16_t len)
 {
   int32_t ret;
+#ifdef ILPS28QSW_BUS_STATS
+  ilps28qsw_bus_stats_t *stats = bus_stats_get(ctx);
+  uint32_t start = bus_stats_start(stats);
+#endif /* ILPS28QSW_BUS_STATS */
+
   ret = ctx->read_reg(ctx->handle, reg, data, len);
+
+#ifdef ILPS28QSW_BUS_STATS
+  bus_stats_end(stats, start);
+  bus_stats_count(stats, 1U, reg, len, ret);
+#endif /* ILPS28QSW_BUS_STATS */
   return ret;
 }
 
@@ -69,29 +187,48 @@ int32_t __weak ilps28qsw_write_reg(stmdev_ctx_t *ctx, uint8_t reg,
                                    uint16_t len)
 {
   int32_t ret;
+#ifdef ILPS28QSW_BUS_STATS
+  ilps28qsw_bus_stats_t *stats = bus_stats_get(ctx);
+  uint32_t start = bus_stats_start(stats);
+#endif /* ILPS28QSW_BUS_STATS */
+
   ret = ctx->write_reg(ctx->handle, reg, data, len);
+
+#ifdef ILPS28QSW_BUS_STATS
+  bus_stats_end(stats, start);
+  bus_stats_count(stats, 0U, reg, len, ret);
+#endif /* ILPS28QSW_BUS_STATS */
   return ret;
 }
 
+#ifdef ILPS28QSW_BUS_STATS
 /**
-  * @}
+  * @brief  Clear the bus instrumentation counters, the cycle counter
+  *         routine is kept.
   *
-  */
-
-/**
-  * @defgroup  Private_functions
-  * @brief     Section collect all the utility functions needed by APIs.
-  * @{
+  * @param  stats  bus instrumentation.(ptr)
   *
   */
-
-static void bytecpy(uint8_t *target, uint8_t *source)
+void ilps28qsw_bus_stats_reset(ilps28qsw_bus_stats_t *stats)
 {
-  if ((target != NULL) && (source != NULL))
+  uint8_t i;
+
+  stats->rd = 0U;
+  stats->wr = 0U;
+  stats->rd_bytes = 0U;
+  stats->wr_bytes = 0U;
+  stats->err = 0U;
+  for (i = 0U; i < ILPS28QSW_STATS_SLOTS; i++)
   {
-    *target = *source;
+    stats->slot_rd[i] = 0U;
+    stats->slot_wr[i] = 0U;
+  }
+  for (i = 0U; i < ILPS28QSW_STATS_BINS; i++)
+  {
+    stats->lat[i] = 0U;
   }
 }
+#endif /* ILPS28QSW_BUS_STATS */
 
 /**
   * @}
@@ -99,662 +236,3804 @@ static void bytecpy(uint8_t *target, uint8_t *source)
   */
 
 /**
-  * @defgroup    Sensitivity
-  * @brief       These functions convert raw-data into engineering units.
+  * @defgroup  Private_functions
+  * @brief     Section collect all the utility functions needed by APIs.
   * @{
   *
   */
 
-float_t ilps28qsw_from_fs1260_to_hPa(int32_t lsb)
-{
-  return ((float_t)lsb / 1048576.0f);   /* 4096.0f * 256 */
-}
-
-float_t ilps28qsw_from_fs4000_to_hPa(int32_t lsb)
+static void bytecpy(uint8_t *target, uint8_t *source)
 {
-  return ((float_t)lsb /  524288.0f);   /* 2048.0f * 256 */
+  if ((target != NULL) && (source != NULL))
+  {
+    *target = *source;
+  }
 }
 
-float_t ilps28qsw_from_lsb_to_celsius(int16_t lsb)
+static ilps28qsw_shadow_t *shadow_get(stmdev_ctx_t *ctx, uint8_t reg,
+                                      uint16_t len)
 {
-  return ((float_t)lsb / 100.0f);
-}
+  ilps28qsw_priv_t *priv = priv_get(ctx);
+  ilps28qsw_shadow_t *shadow = NULL;
 
-/**
-  * @}
-  *
-  */
+  if ((priv != NULL) && (reg >= ILPS28QSW_SHADOW_FIRST) &&
+      (((uint16_t)reg + len) <= ((uint16_t)ILPS28QSW_SHADOW_LAST + 1U)))
+  {
+    shadow = &priv->shadow;
+  }
 
-/**
-  * @defgroup    Basic functions
-  * @brief       This section groups all the functions concerning device basic
-  *              configuration.
-  * @{
-  *
-  */
+  return shadow;
+}
 
-/**
-  * @brief  Device "Who am I".[get]
-  *
-  * @param  ctx   communication interface handler.(ptr)
-  * @param  val   ID values.(ptr)
-  * @retval       interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t ilps28qsw_id_get(stmdev_ctx_t *ctx, ilps28qsw_id_t *val)
+/*
+ * Configuration registers read: served from the shadow copy, when valid,
+ * to save the read phase of read-modify-write operations.
+ */
+static int32_t ilps28qsw_cfg_read(stmdev_ctx_t *ctx, uint8_t reg,
+                                  uint8_t *data, uint16_t len)
 {
-  uint8_t reg;
-  int32_t ret;
+  ilps28qsw_shadow_t *shadow = shadow_get(ctx, reg, len);
+  uint16_t i;
+  int32_t ret = 0;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_WHO_AM_I, &reg, 1);
-  val->whoami = reg;
+  if ((shadow != NULL) && (shadow->valid == PROPERTY_ENABLE))
+  {
+    for (i = 0U; i < len; i++)
+    {
+      data[i] = shadow->reg[(reg - ILPS28QSW_SHADOW_FIRST) + i];
+    }
+  }
+  else
+  {
+    ret = ilps28qsw_read_reg(ctx, reg, data, len);
+  }
 
   return ret;
 }
 
-/**
-  * @brief  Configures the bus operating mode.[set]
-  *
-  * @param  ctx   communication interface handler.(ptr)
-  * @param  val   configures the bus operating mode.(ptr)
-  * @retval       interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t ilps28qsw_bus_mode_set(stmdev_ctx_t *ctx, ilps28qsw_bus_mode_t *val)
+/*
+ * Drop the self-clearing bits from a shadow copy read from the device.
+ */
+static void shadow_keep(ilps28qsw_shadow_t *shadow)
 {
-  ilps28qsw_i3c_if_ctrl_t i3c_if_ctrl;
-  int32_t ret;
+  shadow->reg[ILPS28QSW_INTERRUPT_CFG - ILPS28QSW_SHADOW_FIRST] &=
+    ILPS28QSW_INTERRUPT_CFG_KEEP;
+  shadow->reg[ILPS28QSW_CTRL_REG2 - ILPS28QSW_SHADOW_FIRST] &=
+    ILPS28QSW_CTRL_REG2_KEEP;
+}
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_I3C_IF_CTRL,
-                           (uint8_t *)&i3c_if_ctrl, 1);
-  if (ret == 0)
+/*
+ * Keep the shadow copy aligned with written configuration registers.
+ * Self-clearing bits are not cached; reset and boot invalidate the copy.
+ */
+static void shadow_update(stmdev_ctx_t *ctx, uint8_t reg, const uint8_t *data,
+                          uint16_t len)
+{
+  ilps28qsw_shadow_t *shadow = shadow_get(ctx, reg, len);
+  uint8_t addr;
+  uint16_t i;
+
+  if ((shadow != NULL) && (shadow->valid == PROPERTY_ENABLE))
   {
-    i3c_if_ctrl.asf_on = (uint8_t)val->filter & 0x01U;
-    ret = ilps28qsw_write_reg(ctx, ILPS28QSW_I3C_IF_CTRL,
-                              (uint8_t *)&i3c_if_ctrl, 1);
+    for (i = 0U; i < len; i++)
+    {
+      addr = reg + (uint8_t)i;
+      switch (addr)
+      {
+        case ILPS28QSW_CTRL_REG2:
+          /* boot, swreset (oneshot is not cached) */
+          if ((data[i] & ILPS28QSW_CTRL_REG2_RELOAD) != 0U)
+          {
+            shadow->valid = PROPERTY_DISABLE;
+          }
+          shadow->reg[addr - ILPS28QSW_SHADOW_FIRST] =
+            data[i] & ILPS28QSW_CTRL_REG2_KEEP;
+          break;
+        case ILPS28QSW_INTERRUPT_CFG:
+          /* reset_arp, reset_az */
+          shadow->reg[addr - ILPS28QSW_SHADOW_FIRST] =
+            data[i] & ILPS28QSW_INTERRUPT_CFG_KEEP;
+          break;
+        default:
+          shadow->reg[addr - ILPS28QSW_SHADOW_FIRST] = data[i];
+          break;
+      }
+    }
   }
-  return ret;
 }
 
-/**
-  * @brief  Configures the bus operating mode.[set]
-  *
-  * @param  ctx   communication interface handler.(ptr)
-  * @param  val   configures the bus operating mode.(ptr)
-  * @retval       interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t ilps28qsw_bus_mode_get(stmdev_ctx_t *ctx, ilps28qsw_bus_mode_t *val)
+/*
+ * Configuration registers write: keeps the shadow copy aligned.
+ */
+static int32_t ilps28qsw_cfg_write(stmdev_ctx_t *ctx, uint8_t reg,
+                                   uint8_t *data, uint16_t len)
 {
-  ilps28qsw_i3c_if_ctrl_t i3c_if_ctrl;
   int32_t ret;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_I3C_IF_CTRL,
-                           (uint8_t *)&i3c_if_ctrl, 1);
+  ret = ilps28qsw_write_reg(ctx, reg, data, len);
   if (ret == 0)
   {
-    switch (i3c_if_ctrl.asf_on)
-    {
-      case ILPS28QSW_AUTO:
-        val->filter = ILPS28QSW_AUTO;
-        break;
-      case ILPS28QSW_ALWAYS_ON:
-        val->filter = ILPS28QSW_ALWAYS_ON;
-        break;
-      default:
-        val->filter = ILPS28QSW_AUTO;
-        break;
-    }
+    shadow_update(ctx, reg, data, len);
   }
+
   return ret;
 }
 
-/**
-  * @brief  Configures the bus operating mode.[get]
-  *
-  * @param  ctx   communication interface handler.(ptr)
-  * @param  val   configures the bus operating mode.(ptr)
-  * @retval       interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t ilps28qsw_init_set(stmdev_ctx_t *ctx, ilps28qsw_init_t val)
+/*
+ * Run a list of transfers with the platform batched transfer routine or
+ * one by one, the shadow copy follows the register writes.
+ */
+static int32_t xfer_run(stmdev_ctx_t *ctx, ilps28qsw_xfer_t *xfer, uint8_t n)
 {
-  ilps28qsw_ctrl_reg2_t ctrl_reg2;
-  ilps28qsw_ctrl_reg3_t ctrl_reg3;
-  uint8_t reg[2];
-  int32_t ret;
+  ilps28qsw_priv_t *priv = priv_get(ctx);
+#ifdef ILPS28QSW_BUS_STATS
+  uint32_t start;
+#endif /* ILPS28QSW_BUS_STATS */
+  int32_t ret = 0;
+  uint8_t i;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_CTRL_REG2, reg, 2);
-  if (ret == 0)
+  if ((priv != NULL) && (priv->xfer != NULL))
   {
-    bytecpy((uint8_t *)&ctrl_reg2, &reg[0]);
-    bytecpy((uint8_t *)&ctrl_reg3, &reg[1]);
-
-    switch (val)
+#ifdef ILPS28QSW_BUS_STATS
+    start = bus_stats_start(priv->stats);
+#endif /* ILPS28QSW_BUS_STATS */
+    ret = priv->xfer(ctx->handle, xfer, n);
+#ifdef ILPS28QSW_BUS_STATS
+    bus_stats_end(priv->stats, start);
+#endif /* ILPS28QSW_BUS_STATS */
+    for (i = 0U; i < n; i++)
     {
-      case ILPS28QSW_BOOT:
-        ctrl_reg2.boot = PROPERTY_ENABLE;
-        ret = ilps28qsw_write_reg(ctx, ILPS28QSW_CTRL_REG2,
-                                  (uint8_t *)&ctrl_reg2, 1);
-        break;
-      case ILPS28QSW_RESET:
-        ctrl_reg2.swreset = PROPERTY_ENABLE;
-        ret = ilps28qsw_write_reg(ctx, ILPS28QSW_CTRL_REG2,
-                                  (uint8_t *)&ctrl_reg2, 1);
-        break;
-      case ILPS28QSW_DRV_RDY:
-        ctrl_reg2.bdu = PROPERTY_ENABLE;
-        ctrl_reg3.if_add_inc = PROPERTY_ENABLE;
-        bytecpy(&reg[0], (uint8_t *)&ctrl_reg2);
-        bytecpy(&reg[1], (uint8_t *)&ctrl_reg3);
-        ret = ilps28qsw_write_reg(ctx, ILPS28QSW_CTRL_REG2, reg, 2);
-        break;
-      default:
-        ctrl_reg2.swreset = PROPERTY_ENABLE;
-        ret = ilps28qsw_write_reg(ctx, ILPS28QSW_CTRL_REG2,
-                                  (uint8_t *)&ctrl_reg2, 1);
-        break;
+#ifdef ILPS28QSW_BUS_STATS
+      /* the batch status is counted once, on the first transfer */
+      bus_stats_count(priv->stats, xfer[i].rd, xfer[i].reg, xfer[i].len,
+                      (i == 0U) ? ret : 0);
+#endif /* ILPS28QSW_BUS_STATS */
+      if ((ret == 0) && (xfer[i].rd == 0U))
+      {
+        shadow_update(ctx, xfer[i].reg, xfer[i].data, xfer[i].len);
+      }
+    }
+  }
+  else
+  {
+    for (i = 0U; (i < n) && (ret == 0); i++)
+    {
+      if (xfer[i].rd != 0U)
+      {
+        ret = ilps28qsw_read_reg(ctx, xfer[i].reg, xfer[i].data, xfer[i].len);
+      }
+      else
+      {
+        ret = ilps28qsw_cfg_write(ctx, xfer[i].reg, xfer[i].data, xfer[i].len);
+      }
     }
   }
 
   return ret;
 }
 
-/**
-  * @brief  Get the status of the device.[get]
-  *
-  * @param  ctx   communication interface handler.(ptr)
-  * @param  val   the status of the device.(ptr)
-  * @retval       interface status (MANDATORY: return 0 -> no Error)
-  *
-  */
-int32_t ilps28qsw_status_get(stmdev_ctx_t *ctx, ilps28qsw_stat_t *val)
+/*
+ * Serialize multi-transaction operations when the context is shared by
+ * several tasks: the platform lock must be recursive, as locked operations
+ * call each other.
+ */
+static void bus_lock(stmdev_ctx_t *ctx)
 {
-  ilps28qsw_interrupt_cfg_t interrupt_cfg;
-  ilps28qsw_int_source_t int_source;
-  ilps28qsw_ctrl_reg2_t ctrl_reg2;
-  ilps28qsw_status_t status;
-  int32_t ret;
+  ilps28qsw_priv_t *priv = priv_get(ctx);
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_CTRL_REG2,
-                           (uint8_t *)&ctrl_reg2, 1);
-  if (ret == 0)
+  if ((priv != NULL) && (priv->lock != NULL))
   {
-    ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INT_SOURCE, (uint8_t *)&int_source, 1);
+    priv->lock(priv->lock_handle);
   }
-  if (ret == 0)
-  {
-    ret = ilps28qsw_read_reg(ctx, ILPS28QSW_STATUS, (uint8_t *)&status, 1);
+}
+
+static void bus_unlock(stmdev_ctx_t *ctx)
+{
+  ilps28qsw_priv_t *priv = priv_get(ctx);
+
+  if ((priv != NULL) && (priv->unlock != NULL))
+  {
+    priv->unlock(priv->lock_handle);
+  }
+}
+
+/*
+ * FIFO samples per read burst: context setting, clamped to the 128 FIFO
+ * entries, or ILPS28QSW_FIFO_BURST_MAX.
+ */
+static uint16_t fifo_burst_max(stmdev_ctx_t *ctx)
+{
+  ilps28qsw_priv_t *priv = priv_get(ctx);
+  uint16_t burst = ILPS28QSW_FIFO_BURST_MAX;
+
+  if ((priv != NULL) && (priv->fifo_burst != 0U))
+  {
+    burst = (priv->fifo_burst > 128U) ? 128U : priv->fifo_burst;
+  }
+
+  return burst;
+}
+
+/*
+ * ilps28qsw_mode_set write sequence.
+ * cur holds CTRL_REG1 .. FIFO_CTRL, seq receives the register images:
+ * [0] CTRL_REG1 in power-down, [1] CTRL_REG3 with AH_QVAR disabled,
+ * [2] CTRL_REG3 interleaved setting, [3] FIFO_CTRL, [4..6] CTRL_REG1..3
+ * final, [7] bitmask of the writes to perform, [8] first and [9] number
+ * of CTRL_REG1..3 final bytes to write.
+ * The power-down cycle is only needed when interleaved mode changes,
+ * otherwise only the changed CTRL_REG1..3 bytes are written.
+ */
+static void mode_seq_build(ilps28qsw_md_t *val, uint8_t *cur, uint8_t *seq)
+{
+  ilps28qsw_ctrl_reg1_t ctrl_reg1;
+  ilps28qsw_ctrl_reg2_t ctrl_reg2;
+  ilps28qsw_ctrl_reg3_t ctrl_reg3;
+  ilps28qsw_fifo_ctrl_t fifo_ctrl;
+  uint8_t ah_qvar_en_save = 0;
+  uint8_t mask = 0;
+  uint8_t first = 3U;
+  uint8_t last = 0U;
+  uint8_t i;
+
+  bytecpy((uint8_t *)&ctrl_reg1, &cur[0]);
+  bytecpy((uint8_t *)&ctrl_reg2, &cur[1]);
+  bytecpy((uint8_t *)&ctrl_reg3, &cur[2]);
+  bytecpy((uint8_t *)&fifo_ctrl, &cur[4]);
+
+  if ((ctrl_reg3.ah_qvar_p_auto_en != val->interleaved_mode) ||
+      (fifo_ctrl.ah_qvar_p_fifo_en != val->interleaved_mode))
+  {
+    /* handle interleaved mode setting */
+    if (ctrl_reg1.odr != 0x0U)
+    {
+      /* power-down */
+      ctrl_reg1.odr = 0x0U;
+      bytecpy(&seq[0], (uint8_t *)&ctrl_reg1);
+      mask |= 0x01U;
+    }
+
+    if (ctrl_reg3.ah_qvar_en != 0U)
+    {
+      /* disable QVAR */
+      ah_qvar_en_save = ctrl_reg3.ah_qvar_en;
+      ctrl_reg3.ah_qvar_en = 0;
+      bytecpy(&seq[1], (uint8_t *)&ctrl_reg3);
+      mask |= 0x02U;
+    }
+
+    /* set interleaved mode (0 or 1) */
+    ctrl_reg3.ah_qvar_p_auto_en = val->interleaved_mode;
+    bytecpy(&seq[2], (uint8_t *)&ctrl_reg3);
+
+    /* set FIFO interleaved mode (0 or 1) */
+    fifo_ctrl.ah_qvar_p_fifo_en = val->interleaved_mode;
+    bytecpy(&seq[3], (uint8_t *)&fifo_ctrl);
+    mask |= 0x0CU;
+
+    if (ah_qvar_en_save != 0U)
+    {
+      /* restore ah_qvar_en back to previous setting */
+      ctrl_reg3.ah_qvar_en = ah_qvar_en_save;
+    }
+  }
+
+  ctrl_reg1.odr = (uint8_t)val->odr;
+  ctrl_reg1.avg = (uint8_t)val->avg;
+  ctrl_reg2.en_lpfp = (uint8_t)val->lpf & 0x01U;
+  ctrl_reg2.lfpf_cfg = ((uint8_t)val->lpf & 0x02U) >> 1;
+  ctrl_reg2.fs_mode = (uint8_t)val->fs;
+
+  bytecpy(&seq[4], (uint8_t *)&ctrl_reg1);
+  bytecpy(&seq[5], (uint8_t *)&ctrl_reg2);
+  bytecpy(&seq[6], (uint8_t *)&ctrl_reg3);
+
+  if (mask != 0U)
+  {
+    /* after power-down all of CTRL_REG1 .. CTRL_REG3 is rewritten */
+    first = 0U;
+    last = 2U;
+  }
+  else
+  {
+    for (i = 0U; i < 3U; i++)
+    {
+      if (seq[4U + i] != cur[i])
+      {
+        first = (first > i) ? i : first;
+        last = i;
+      }
+    }
+  }
+
+  if (first < 3U)
+  {
+    mask |= 0x10U;
+    seq[8] = first;
+    seq[9] = last - first + 1U;
+  }
+
+  seq[7] = mask;
+}
+
+/*
+ * Write of step idx of the mode_set sequence, returns 0 if skipped.
+ */
+static uint8_t mode_seq_get(uint8_t *seq, uint8_t idx, uint8_t *reg,
+                            uint8_t **data, uint16_t *len)
+{
+  static const uint8_t seq_reg[5] =
+  {
+    ILPS28QSW_CTRL_REG1, ILPS28QSW_CTRL_REG3, ILPS28QSW_CTRL_REG3,
+    ILPS28QSW_FIFO_CTRL, ILPS28QSW_CTRL_REG1,
+  };
+  uint8_t ret = 0U;
+
+  if ((idx < 5U) && ((seq[7] & (1U << idx)) != 0U))
+  {
+    *reg = seq_reg[idx];
+    *data = &seq[idx];
+    *len = 1U;
+    if (idx == 4U)
+    {
+      *reg += seq[8];
+      *data = &seq[4U + seq[8]];
+      *len = seq[9];
+    }
+    ret = 1U;
+  }
+
+  return ret;
+}
+
+/*
+ * Decode INT_SOURCE, FIFO_STATUS1, FIFO_STATUS2, STATUS (0x24 - 0x27).
+ */
+static void sources_decode(uint8_t *reg, ilps28qsw_all_sources_t *val)
+{
+  ilps28qsw_fifo_status2_t fifo_status2;
+  ilps28qsw_int_source_t int_source;
+  ilps28qsw_status_t status;
+
+  bytecpy((uint8_t *)&int_source, &reg[0]);
+  bytecpy((uint8_t *)&fifo_status2, &reg[2]);
+  bytecpy((uint8_t *)&status, &reg[3]);
+
+  val->drdy_pres        = status.p_da;
+  val->drdy_temp        = status.t_da;
+  val->over_pres        = int_source.ph;
+  val->under_pres       = int_source.pl;
+  val->thrsld_pres      = int_source.ia;
+  val->fifo_full        = fifo_status2.fifo_full_ia;
+  val->fifo_ovr         = fifo_status2.fifo_ovr_ia;
+  val->fifo_th          = fifo_status2.fifo_wtm_ia;
+}
+
+/*
+ * Decode PRESS_OUT_XL .. TEMP_OUT_H (0x28 - 0x2C).
+ */
+static void data_decode(ilps28qsw_md_t *md, uint8_t *buff,
+                        ilps28qsw_data_t *data)
+{
+  /* pressure conversion */
+  data->pressure.raw = (int32_t)buff[2];
+  data->pressure.raw = (data->pressure.raw * 256) + (int32_t) buff[1];
+  data->pressure.raw = (data->pressure.raw * 256) + (int32_t) buff[0];
+  data->pressure.raw = data->pressure.raw * 256;
+
+  if (md->interleaved_mode == 1U)
+  {
+    if ((buff[0] & 0x1U) == 0U)
+    {
+      /* data is a pressure sample */
+      switch (md->fs)
+      {
+        case ILPS28QSW_1260hPa:
+          data->pressure.hpa = ilps28qsw_from_fs1260_to_hPa(data->pressure.raw);
+          break;
+        case ILPS28QSW_4060hPa:
+          data->pressure.hpa = ilps28qsw_from_fs4000_to_hPa(data->pressure.raw);
+          break;
+        default:
+          data->pressure.hpa = 0.0f;
+          break;
+      }
+      data->ah_qvar.lsb = 0;
+    }
+    else
+    {
+      /* data is a AH_QVAR sample */
+      data->ah_qvar.lsb = (data->pressure.raw / 256); /* shift 8bit left */
+      data->pressure.hpa = 0.0f;
+    }
+  }
+  else
+  {
+    switch (md->fs)
+    {
+      case ILPS28QSW_1260hPa:
+        data->pressure.hpa = ilps28qsw_from_fs1260_to_hPa(data->pressure.raw);
+        break;
+      case ILPS28QSW_4060hPa:
+        data->pressure.hpa = ilps28qsw_from_fs4000_to_hPa(data->pressure.raw);
+        break;
+      default:
+        data->pressure.hpa = 0.0f;
+        break;
+    }
+    data->ah_qvar.lsb = 0;
+  }
+
+  /* temperature conversion */
+  data->heat.raw = (int16_t)buff[4];
+  data->heat.raw = (data->heat.raw * 256) + (int16_t) buff[3];
+  data->heat.deg_c = ilps28qsw_from_lsb_to_celsius(data->heat.raw);
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup    Sensitivity
+  * @brief       These functions convert raw-data into engineering units.
+  * @{
+  *
+  */
+
+float_t ilps28qsw_from_fs1260_to_hPa(int32_t lsb)
+{
+  return ((float_t)lsb / 1048576.0f);   /* 4096.0f * 256 */
+}
+
+float_t ilps28qsw_from_fs4000_to_hPa(int32_t lsb)
+{
+  return ((float_t)lsb /  524288.0f);   /* 2048.0f * 256 */
+}
+
+float_t ilps28qsw_from_lsb_to_celsius(int16_t lsb)
+{
+  return ((float_t)lsb / 100.0f);
+}
+
+/*
+ * Integer conversions: pressure in cPa (0.01 Pa), temperature in 0.01 degC.
+ * x * 10000 / 2^n is split as x * 625 / 2^(n-4) to stay within 32 bit.
+ */
+int32_t ilps28qsw_from_fs1260_to_cPa(int32_t lsb)
+{
+  return ((lsb / 65536) * 625) + (((lsb % 65536) * 625) / 65536);
+}
+
+int32_t ilps28qsw_from_fs4000_to_cPa(int32_t lsb)
+{
+  return ((lsb / 32768) * 625) + (((lsb % 32768) * 625) / 32768);
+}
+
+int16_t ilps28qsw_from_lsb_to_cdeg_c(int16_t lsb)
+{
+  return lsb;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup    Shadow registers
+  * @brief       These functions manage the copy of the configuration
+  *              registers kept in ilps28qsw_priv_t (ctx->priv_data).
+  * @{
+  *
+  */
+
+/**
+  * @brief  Fill the shadow copy of configuration registers with a single
+  *         burst read. Call it at init and after ILPS28QSW_RESET or
+  *         ILPS28QSW_BOOT have completed.
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_shadow_sync(stmdev_ctx_t *ctx)
+{
+  ilps28qsw_shadow_t *shadow;
+  int32_t ret = 0;
+
+  bus_lock(ctx);
+  shadow = shadow_get(ctx, ILPS28QSW_SHADOW_FIRST, ILPS28QSW_SHADOW_LEN);
+  if (shadow != NULL)
+  {
+    shadow->valid = PROPERTY_DISABLE;
+    ret = ilps28qsw_read_reg(ctx, ILPS28QSW_SHADOW_FIRST, shadow->reg,
+                             ILPS28QSW_SHADOW_LEN);
+    if (ret == 0)
+    {
+      shadow_keep(shadow);
+      shadow->valid = PROPERTY_ENABLE;
+    }
+  }
+
+  bus_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Save the configuration registers, from the shadow registers
+  *         when valid.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  snap  configuration snapshot.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_cfg_snap_save(stmdev_ctx_t *ctx, ilps28qsw_cfg_snap_t *snap)
+{
+  int32_t ret;
+
+  ret = ilps28qsw_cfg_read(ctx, ILPS28QSW_SHADOW_FIRST, snap->reg,
+                           ILPS28QSW_SHADOW_LEN);
+
+  return ret;
+}
+
+/**
+  * @brief  Resume a saved configuration without BOOT: one burst read of
+  *         INTERRUPT_CFG .. I3C_IF_CTRL, then write of the registers
+  *         differing from the snapshot only, in contiguous bursts.
+  *         WHO_AM_I, reserved, REF_P and self-clearing bits are not
+  *         compared. FIFO_CTRL is rewritten only if it differs, so FIFO
+  *         content is kept. A change of interleaved mode follows the
+  *         ilps28qsw_mode_set() power-down sequence. Shadow registers are
+  *         refreshed.
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  snap  configuration snapshot.(ptr)
+  * @retval       0 -> no Error, -1 -> WHO_AM_I mismatch (e.g. other device
+  *               or address auto-increment disabled), nothing written
+  *
+  */
+int32_t ilps28qsw_resume(stmdev_ctx_t *ctx, const ilps28qsw_cfg_snap_t *snap)
+{
+  /* compared bits: 0 for WHO_AM_I, reserved, REF_P, self-clearing bits */
+  static const uint8_t mask[ILPS28QSW_SHADOW_LEN] =
+  {
+    ILPS28QSW_INTERRUPT_CFG_KEEP, 0xFFU, 0xFFU, 0xFFU, 0x00U, 0xFFU,
+    ILPS28QSW_CTRL_REG2_KEEP, 0xFFU, 0x00U, 0xFFU, 0xFFU, 0x00U, 0x00U,
+    0x00U, 0xFFU,
+  };
+  ilps28qsw_ctrl_reg1_t ctrl_reg1;
+  ilps28qsw_ctrl_reg3_t ctrl_reg3;
+  ilps28qsw_ctrl_reg3_t snap_reg3;
+  ilps28qsw_fifo_ctrl_t fifo_ctrl;
+  ilps28qsw_fifo_ctrl_t snap_fifo;
+  ilps28qsw_shadow_t *shadow;
+  ilps28qsw_xfer_t xfer[13];
+  uint8_t cur[ILPS28QSW_SHADOW_LEN];
+  uint8_t wr[ILPS28QSW_SHADOW_LEN];
+  uint8_t pre[3];
+  uint8_t end = ILPS28QSW_SHADOW_LEN;
+  uint8_t inc;
+  uint8_t n = 0U;
+  uint8_t i;
+  int32_t ret;
+
+  bus_lock(ctx);
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_SHADOW_FIRST, cur,
+                           ILPS28QSW_SHADOW_LEN);
+
+  if ((ret == 0) &&
+      (cur[ILPS28QSW_WHO_AM_I - ILPS28QSW_SHADOW_FIRST] != ILPS28QSW_ID))
+  {
+    ret = -1;
+  }
+
+  if (ret == 0)
+  {
+    shadow = shadow_get(ctx, ILPS28QSW_SHADOW_FIRST, ILPS28QSW_SHADOW_LEN);
+    if (shadow != NULL)
+    {
+      for (i = 0U; i < ILPS28QSW_SHADOW_LEN; i++)
+      {
+        shadow->reg[i] = cur[i];
+      }
+      shadow_keep(shadow);
+      shadow->valid = PROPERTY_ENABLE;
+    }
+
+    for (i = 0U; i < ILPS28QSW_SHADOW_LEN; i++)
+    {
+      wr[i] = snap->reg[i] & mask[i];
+    }
+
+    bytecpy((uint8_t *)&ctrl_reg1,
+            &cur[ILPS28QSW_CTRL_REG1 - ILPS28QSW_SHADOW_FIRST]);
+    bytecpy((uint8_t *)&ctrl_reg3,
+            &cur[ILPS28QSW_CTRL_REG3 - ILPS28QSW_SHADOW_FIRST]);
+    bytecpy((uint8_t *)&fifo_ctrl,
+            &cur[ILPS28QSW_FIFO_CTRL - ILPS28QSW_SHADOW_FIRST]);
+    bytecpy((uint8_t *)&snap_reg3,
+            &wr[ILPS28QSW_CTRL_REG3 - ILPS28QSW_SHADOW_FIRST]);
+    bytecpy((uint8_t *)&snap_fifo,
+            &wr[ILPS28QSW_FIFO_CTRL - ILPS28QSW_SHADOW_FIRST]);
+    inc = ctrl_reg3.if_add_inc;
+
+    if ((ctrl_reg3.ah_qvar_p_auto_en != snap_reg3.ah_qvar_p_auto_en) ||
+        (fifo_ctrl.ah_qvar_p_fifo_en != snap_fifo.ah_qvar_p_fifo_en))
+    {
+      /* interleaved mode: power-down and QVAR disabled while changing */
+      if (ctrl_reg1.odr != 0x0U)
+      {
+        ctrl_reg1.odr = 0x0U;
+        bytecpy(&pre[0], (uint8_t *)&ctrl_reg1);
+        xfer[n].reg = ILPS28QSW_CTRL_REG1;
+        xfer[n].data = &pre[0];
+        n++;
+      }
+
+      ctrl_reg3 = snap_reg3;
+      ctrl_reg3.ah_qvar_en = 0U;
+      bytecpy(&pre[1], (uint8_t *)&ctrl_reg3);
+      xfer[n].reg = ILPS28QSW_CTRL_REG3;
+      xfer[n].data = &pre[1];
+      n++;
+
+      pre[2] = wr[ILPS28QSW_FIFO_CTRL - ILPS28QSW_SHADOW_FIRST];
+      xfer[n].reg = ILPS28QSW_FIFO_CTRL;
+      xfer[n].data = &pre[2];
+      n++;
+
+      for (i = 0U; i < n; i++)
+      {
+        xfer[i].rd = 0U;
+        xfer[i].len = 1U;
+        cur[xfer[i].reg - ILPS28QSW_SHADOW_FIRST] = *xfer[i].data;
+      }
+      inc = snap_reg3.if_add_inc;
+    }
+
+    /* contiguous differing registers in one write, if auto-increment */
+    for (i = 0U; i < ILPS28QSW_SHADOW_LEN; i++)
+    {
+      if (((cur[i] ^ snap->reg[i]) & mask[i]) == 0U)
+      {
+        /* same value or not compared */
+      }
+      else if ((end == i) && (inc == PROPERTY_ENABLE))
+      {
+        xfer[n - 1U].len++;
+        end = i + 1U;
+      }
+      else
+      {
+        xfer[n].reg = ILPS28QSW_SHADOW_FIRST + i;
+        xfer[n].rd = 0U;
+        xfer[n].len = 1U;
+        xfer[n].data = &wr[i];
+        n++;
+        end = i + 1U;
+      }
+
+      if ((ILPS28QSW_SHADOW_FIRST + i) == ILPS28QSW_CTRL_REG3)
+      {
+        /* next bursts follow the restored if_add_inc */
+        inc = snap_reg3.if_add_inc;
+      }
+    }
+
+    ret = xfer_run(ctx, xfer, n);
+  }
+
+  bus_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Discard the shadow copy of configuration registers: following
+  *         operations read the device until ilps28qsw_shadow_sync is called.
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  *
+  */
+void ilps28qsw_shadow_invalidate(stmdev_ctx_t *ctx)
+{
+  ilps28qsw_shadow_t *shadow;
+
+  shadow = shadow_get(ctx, ILPS28QSW_SHADOW_FIRST, ILPS28QSW_SHADOW_LEN);
+  if (shadow != NULL)
+  {
+    shadow->valid = PROPERTY_DISABLE;
+  }
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup    UCF configuration
+  * @brief       This section groups the functions to apply UCF / Unico
+  *              configurations.
+  * @{
+  *
+  */
+
+/*
+ * UCF line which would leave the configuration unchanged.
+ */
+static uint8_t ucf_cached(stmdev_ctx_t *ctx, const ucf_line_t *line)
+{
+  ilps28qsw_shadow_t *shadow = shadow_get(ctx, line->address, 1U);
+  uint8_t ret = 0U;
+
+  /* self-clearing bits are never cached, so the triggers are not skipped */
+  if ((shadow != NULL) && (shadow->valid == PROPERTY_ENABLE) &&
+      (shadow->reg[line->address - ILPS28QSW_SHADOW_FIRST] == line->data))
+  {
+    ret = 1U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Apply a UCF configuration. Lines with consecutive addresses
+  *         are written with a single burst while register address
+  *         auto-increment (if_add_inc) is enabled, following its changes
+  *         along the configuration.
+  *
+  * @param  ctx          communication interface handler.(ptr)
+  * @param  ucf          configuration lines.(ptr)
+  * @param  len          number of lines.
+  * @param  skip_cached  skip lines matching the shadow copy of registers.
+  * @retval              interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_ucf_load(stmdev_ctx_t *ctx, const ucf_line_t *ucf,
+                           uint16_t len, uint8_t skip_cached)
+{
+  ilps28qsw_ctrl_reg3_t ctrl_reg3;
+  uint8_t buff[ILPS28QSW_UCF_BURST_MAX];
+  uint8_t inc;
+  uint8_t reg = 0U;
+  uint8_t addr;
+  uint16_t n = 0U;
+  uint16_t i;
+  int32_t ret;
+
+  bus_lock(ctx);
+  ret = ilps28qsw_cfg_read(ctx, ILPS28QSW_CTRL_REG3, (uint8_t *)&ctrl_reg3, 1);
+  inc = ctrl_reg3.if_add_inc;
+
+  for (i = 0U; (i < len) && (ret == 0); i++)
+  {
+    addr = ucf[i].address;
+
+    if ((skip_cached == PROPERTY_ENABLE) && (ucf_cached(ctx, &ucf[i]) != 0U))
+    {
+      /* nothing to write, close the burst in progress */
+      if (n > 0U)
+      {
+        ret = ilps28qsw_cfg_write(ctx, reg, buff, n);
+        n = 0U;
+      }
+    }
+    else
+    {
+      /* extend the burst, it must not cross the shadow copy boundaries */
+      if ((n > 0U) && ((inc == 0U) || (n == ILPS28QSW_UCF_BURST_MAX) ||
+                       (addr != (uint8_t)(reg + n)) ||
+                       (addr == ILPS28QSW_SHADOW_FIRST) ||
+                       (addr == (ILPS28QSW_SHADOW_LAST + 1U))))
+      {
+        ret = ilps28qsw_cfg_write(ctx, reg, buff, n);
+        n = 0U;
+      }
+
+      if (n == 0U)
+      {
+        reg = addr;
+      }
+      buff[n] = ucf[i].data;
+      n++;
+
+      if (addr == ILPS28QSW_CTRL_REG3)
+      {
+        /* new auto-increment setting applies from the next burst */
+        bytecpy((uint8_t *)&ctrl_reg3, &buff[n - 1U]);
+        inc = ctrl_reg3.if_add_inc;
+      }
+      else if ((addr == ILPS28QSW_CTRL_REG2) &&
+               ((buff[n - 1U] & ILPS28QSW_CTRL_REG2_RELOAD) != 0U))
+      {
+        /* boot and software reset end the burst, restore auto-increment */
+        ret = ilps28qsw_cfg_write(ctx, reg, buff, n);
+        n = 0U;
+        inc = PROPERTY_ENABLE;
+      }
+      else
+      {
+        /* no influence on the interface */
+      }
+    }
+  }
+
+  if ((n > 0U) && (ret == 0))
+  {
+    ret = ilps28qsw_cfg_write(ctx, reg, buff, n);
+  }
+
+  bus_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup    Basic functions
+  * @brief       This section groups all the functions concerning device basic
+  *              configuration.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Device "Who am I".[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  val   ID values.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_id_get(stmdev_ctx_t *ctx, ilps28qsw_id_t *val)
+{
+  uint8_t reg;
+  int32_t ret;
+
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_WHO_AM_I, &reg, 1);
+  val->whoami = reg;
+
+  return ret;
+}
+
+/**
+  * @brief  Probe the devices of an array of contexts by WHO_AM_I, e.g.
+  *         after the I3C dynamic address assignment made by the bus
+  *         controller, with one context per assigned address.
+  *
+  * @param  ctx    array of n communication interface handlers.(ptr)
+  * @param  n      number of contexts.
+  * @param  found  1 if an ILPS28QSW answers on the context, NULL to
+  *                skip.(ptr)
+  * @retval        number of devices found
+  *
+  */
+uint8_t ilps28qsw_discover(stmdev_ctx_t *ctx, uint8_t n, uint8_t *found)
+{
+  ilps28qsw_id_t id;
+  uint8_t cnt = 0U;
+  uint8_t ok;
+  uint8_t i;
+
+  for (i = 0U; i < n; i++)
+  {
+    ok = ((ilps28qsw_id_get(&ctx[i], &id) == 0) &&
+          (id.whoami == ILPS28QSW_ID)) ? 1U : 0U;
+    if (found != NULL)
+    {
+      found[i] = ok;
+    }
+    cnt += ok;
+  }
+
+  return cnt;
+}
+
+/**
+  * @brief  Configures the bus operating mode.[set]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  val   configures the bus operating mode.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_bus_mode_set(stmdev_ctx_t *ctx, ilps28qsw_bus_mode_t *val)
+{
+  ilps28qsw_i3c_if_ctrl_t i3c_if_ctrl;
+  int32_t ret;
+
+  bus_lock(ctx);
+  ret = ilps28qsw_cfg_read(ctx, ILPS28QSW_I3C_IF_CTRL,
+                           (uint8_t *)&i3c_if_ctrl, 1);
+  if (ret == 0)
+  {
+    i3c_if_ctrl.asf_on = (uint8_t)val->filter & 0x01U;
+    ret = ilps28qsw_cfg_write(ctx, ILPS28QSW_I3C_IF_CTRL,
+                              (uint8_t *)&i3c_if_ctrl, 1);
+  }
+
+  bus_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Configures the bus operating mode.[set]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  val   configures the bus operating mode.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_bus_mode_get(stmdev_ctx_t *ctx, ilps28qsw_bus_mode_t *val)
+{
+  ilps28qsw_i3c_if_ctrl_t i3c_if_ctrl;
+  int32_t ret;
+
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_I3C_IF_CTRL,
+                           (uint8_t *)&i3c_if_ctrl, 1);
+  if (ret == 0)
+  {
+    switch (i3c_if_ctrl.asf_on)
+    {
+      case ILPS28QSW_AUTO:
+        val->filter = ILPS28QSW_AUTO;
+        break;
+      case ILPS28QSW_ALWAYS_ON:
+        val->filter = ILPS28QSW_ALWAYS_ON;
+        break;
+      default:
+        val->filter = ILPS28QSW_AUTO;
+        break;
+    }
+  }
+  return ret;
+}
+
+/**
+  * @brief  Configures the bus operating mode.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  val   configures the bus operating mode.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_init_set(stmdev_ctx_t *ctx, ilps28qsw_init_t val)
+{
+  ilps28qsw_ctrl_reg2_t ctrl_reg2;
+  ilps28qsw_ctrl_reg3_t ctrl_reg3;
+  uint8_t reg[2];
+  int32_t ret;
+
+  bus_lock(ctx);
+  ret = ilps28qsw_cfg_read(ctx, ILPS28QSW_CTRL_REG2, reg, 2);
+  if (ret == 0)
+  {
+    bytecpy((uint8_t *)&ctrl_reg2, &reg[0]);
+    bytecpy((uint8_t *)&ctrl_reg3, &reg[1]);
+
+    switch (val)
+    {
+      case ILPS28QSW_BOOT:
+        ctrl_reg2.boot = PROPERTY_ENABLE;
+        ret = ilps28qsw_cfg_write(ctx, ILPS28QSW_CTRL_REG2,
+                                  (uint8_t *)&ctrl_reg2, 1);
+        break;
+      case ILPS28QSW_RESET:
+        ctrl_reg2.swreset = PROPERTY_ENABLE;
+        ret = ilps28qsw_cfg_write(ctx, ILPS28QSW_CTRL_REG2,
+                                  (uint8_t *)&ctrl_reg2, 1);
+        break;
+      case ILPS28QSW_DRV_RDY:
+        ctrl_reg2.bdu = PROPERTY_ENABLE;
+        ctrl_reg3.if_add_inc = PROPERTY_ENABLE;
+        bytecpy(&reg[0], (uint8_t *)&ctrl_reg2);
+        bytecpy(&reg[1], (uint8_t *)&ctrl_reg3);
+        ret = ilps28qsw_cfg_write(ctx, ILPS28QSW_CTRL_REG2, reg, 2);
+        break;
+      default:
+        ctrl_reg2.swreset = PROPERTY_ENABLE;
+        ret = ilps28qsw_cfg_write(ctx, ILPS28QSW_CTRL_REG2,
+                                  (uint8_t *)&ctrl_reg2, 1);
+        break;
+    }
+  }
+
+  bus_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Get the status of the device.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  val   the status of the device.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_status_get(stmdev_ctx_t *ctx, ilps28qsw_stat_t *val)
+{
+  ilps28qsw_interrupt_cfg_t interrupt_cfg;
+  ilps28qsw_int_source_t int_source;
+  ilps28qsw_ctrl_reg2_t ctrl_reg2;
+  ilps28qsw_status_t status;
+  ilps28qsw_xfer_t xfer[2];
+  uint8_t reg[11];
+  int32_t ret;
+
+  /* INTERRUPT_CFG .. CTRL_REG2 and INT_SOURCE .. STATUS */
+  xfer[0].reg = ILPS28QSW_INTERRUPT_CFG;
+  xfer[0].rd = 1U;
+  xfer[0].len = 7U;
+  xfer[0].data = &reg[0];
+  xfer[1].reg = ILPS28QSW_INT_SOURCE;
+  xfer[1].rd = 1U;
+  xfer[1].len = 4U;
+  xfer[1].data = &reg[7];
+  ret = xfer_run(ctx, xfer, 2U);
+
+  bytecpy((uint8_t *)&interrupt_cfg, &reg[0]);
+  bytecpy((uint8_t *)&ctrl_reg2, &reg[6]);
+  bytecpy((uint8_t *)&int_source, &reg[7]);
+  bytecpy((uint8_t *)&status, &reg[10]);
+
+  val->sw_reset  = ctrl_reg2.swreset;
+  val->boot      = int_source.boot_on;
+  val->drdy_pres = status.p_da;
+  val->drdy_temp = status.t_da;
+  val->ovr_pres  = status.p_or;
+  val->ovr_temp  = status.t_or;
+  val->end_meas  = ~ctrl_reg2.oneshot;
+  val->ref_done = ~interrupt_cfg.autozero;
+
+  return ret;
+}
+
+/**
+  * @brief  Electrical pin configuration.[set]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  val   the electrical settings for the configurable pins.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_pin_conf_set(stmdev_ctx_t *ctx, ilps28qsw_pin_conf_t *val)
+{
+  ilps28qsw_if_ctrl_t if_ctrl;
+  int32_t ret;
+
+  bus_lock(ctx);
+  ret = ilps28qsw_cfg_read(ctx, ILPS28QSW_IF_CTRL, (uint8_t *)&if_ctrl, 1);
+
+  if (ret == 0)
+  {
+    if_ctrl.sda_pu_en = val->sda_pull_up;
+    ret = ilps28qsw_cfg_write(ctx, ILPS28QSW_IF_CTRL, (uint8_t *)&if_ctrl, 1);
+  }
+
+  bus_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Electrical pin configuration.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  val   the electrical settings for the configurable pins.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_pin_conf_get(stmdev_ctx_t *ctx, ilps28qsw_pin_conf_t *val)
+{
+  ilps28qsw_if_ctrl_t if_ctrl;
+  int32_t ret;
+
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_IF_CTRL, (uint8_t *)&if_ctrl, 1);
+
+  val->sda_pull_up  = if_ctrl.sda_pu_en;
+
+  return ret;
+}
+
+/**
+  * @brief  Get the status of all the interrupt sources.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  val   the status of all the interrupt sources.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_all_sources_get(stmdev_ctx_t *ctx,
+                                  ilps28qsw_all_sources_t *val)
+{
+  uint8_t reg[4];
+  int32_t ret;
+
+  /* INT_SOURCE .. STATUS */
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INT_SOURCE, reg, 4);
+  sources_decode(reg, val);
+
+  return ret;
+}
+
+/**
+  * @brief  Interrupt sources, status, FIFO level and output data in a
+  *         single burst read (INT_SOURCE .. TEMP_OUT_H).[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  val   snapshot of the device.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_poll_snapshot_get(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                                    ilps28qsw_poll_snapshot_t *val)
+{
+  ilps28qsw_fifo_status1_t fifo_status1;
+  ilps28qsw_int_source_t int_source;
+  ilps28qsw_status_t status;
+  uint8_t reg[9];
+  int32_t ret;
+
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INT_SOURCE, reg, 9);
+
+  bytecpy((uint8_t *)&int_source, &reg[0]);
+  bytecpy((uint8_t *)&fifo_status1, &reg[1]);
+  bytecpy((uint8_t *)&status, &reg[3]);
+
+  sources_decode(reg, &val->sources);
+  val->boot       = int_source.boot_on;
+  val->ovr_pres   = status.p_or;
+  val->ovr_temp   = status.t_or;
+  val->fifo_level = fifo_status1.fss;
+  data_decode(md, &reg[4], &val->data);
+
+  return ret;
+}
+
+/**
+  * @brief  Sensor conversion parameters selection.[set]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  val   set the sensor conversion parameters.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_mode_set(stmdev_ctx_t *ctx, ilps28qsw_md_t *val)
+{
+  ilps28qsw_xfer_t xfer[5];
+  uint8_t seq[10];
+  uint8_t reg[5];
+  uint8_t idx;
+  uint8_t n = 0U;
+  int32_t ret;
+
+  bus_lock(ctx);
+  /* CTRL_REG1 .. FIFO_CTRL */
+  ret = ilps28qsw_cfg_read(ctx, ILPS28QSW_CTRL_REG1, reg, 5);
+
+  if (ret == 0)
+  {
+    mode_seq_build(val, reg, seq);
+
+    for (idx = 0U; idx < 5U; idx++)
+    {
+      if (mode_seq_get(seq, idx, &xfer[n].reg, &xfer[n].data,
+                       &xfer[n].len) != 0U)
+      {
+        xfer[n].rd = 0U;
+        n++;
+      }
+    }
+
+    ret = xfer_run(ctx, xfer, n);
+  }
+
+  bus_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Sensor conversion parameters selection.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  val   get the sensor conversion parameters.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_mode_get(stmdev_ctx_t *ctx, ilps28qsw_md_t *val)
+{
+  ilps28qsw_ctrl_reg1_t ctrl_reg1;
+  ilps28qsw_ctrl_reg2_t ctrl_reg2;
+  ilps28qsw_ctrl_reg3_t ctrl_reg3;
+  uint8_t reg[3];
+  int32_t ret;
+
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_CTRL_REG1, reg, 3);
+
+  if (ret == 0)
+  {
+    bytecpy((uint8_t *)&ctrl_reg1, &reg[0]);
+    bytecpy((uint8_t *)&ctrl_reg2, &reg[1]);
+    bytecpy((uint8_t *)&ctrl_reg3, &reg[2]);
+
+    switch (ctrl_reg2.fs_mode)
+    {
+      case ILPS28QSW_1260hPa:
+        val->fs = ILPS28QSW_1260hPa;
+        break;
+      case ILPS28QSW_4060hPa:
+        val->fs = ILPS28QSW_4060hPa;
+        break;
+      default:
+        val->fs = ILPS28QSW_1260hPa;
+        break;
+    }
+
+    switch (ctrl_reg1.odr)
+    {
+      case ILPS28QSW_ONE_SHOT:
+        val->odr = ILPS28QSW_ONE_SHOT;
+        break;
+      case ILPS28QSW_1Hz:
+        val->odr = ILPS28QSW_1Hz;
+        break;
+      case ILPS28QSW_4Hz:
+        val->odr = ILPS28QSW_4Hz;
+        break;
+      case ILPS28QSW_10Hz:
+        val->odr = ILPS28QSW_10Hz;
+        break;
+      case ILPS28QSW_25Hz:
+        val->odr = ILPS28QSW_25Hz;
+        break;
+      case ILPS28QSW_50Hz:
+        val->odr = ILPS28QSW_50Hz;
+        break;
+      case ILPS28QSW_75Hz:
+        val->odr = ILPS28QSW_75Hz;
+        break;
+      case ILPS28QSW_100Hz:
+        val->odr = ILPS28QSW_100Hz;
+        break;
+      case ILPS28QSW_200Hz:
+        val->odr = ILPS28QSW_200Hz;
+        break;
+      default:
+        val->odr = ILPS28QSW_ONE_SHOT;
+        break;
+    }
+
+    switch (ctrl_reg1.avg)
+    {
+      case ILPS28QSW_4_AVG:
+        val->avg = ILPS28QSW_4_AVG;
+        break;
+      case ILPS28QSW_8_AVG:
+        val->avg = ILPS28QSW_8_AVG;
+        break;
+      case ILPS28QSW_16_AVG:
+        val->avg = ILPS28QSW_16_AVG;
+        break;
+      case ILPS28QSW_32_AVG:
+        val->avg = ILPS28QSW_32_AVG;
+        break;
+      case ILPS28QSW_64_AVG:
+        val->avg = ILPS28QSW_64_AVG;
+        break;
+      case ILPS28QSW_128_AVG:
+        val->avg = ILPS28QSW_128_AVG;
+        break;
+      case ILPS28QSW_256_AVG:
+        val->avg = ILPS28QSW_256_AVG;
+        break;
+      case ILPS28QSW_512_AVG:
+        val->avg = ILPS28QSW_512_AVG;
+        break;
+      default:
+        val->avg = ILPS28QSW_4_AVG;
+        break;
+    }
+
+    switch ((ctrl_reg2.lfpf_cfg << 1) | ctrl_reg2.en_lpfp)
+    {
+      case ILPS28QSW_LPF_DISABLE:
+        val->lpf = ILPS28QSW_LPF_DISABLE;
+        break;
+      case ILPS28QSW_LPF_ODR_DIV_4:
+        val->lpf = ILPS28QSW_LPF_ODR_DIV_4;
+        break;
+      case ILPS28QSW_LPF_ODR_DIV_9:
+        val->lpf = ILPS28QSW_LPF_ODR_DIV_9;
+        break;
+      default:
+        val->lpf = ILPS28QSW_LPF_DISABLE;
+        break;
+    }
+
+    val->interleaved_mode = ctrl_reg3.ah_qvar_p_auto_en;
+  }
+  return ret;
+}
+
+/**
+  * @brief  Software trigger for One-Shot.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_trigger_sw(stmdev_ctx_t *ctx, ilps28qsw_md_t *md)
+{
+  ilps28qsw_ctrl_reg2_t ctrl_reg2;
+  int32_t ret = 0;
+
+  bus_lock(ctx);
+  if (md->odr == ILPS28QSW_ONE_SHOT)
+  {
+    ret = ilps28qsw_cfg_read(ctx, ILPS28QSW_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+    ctrl_reg2.oneshot = PROPERTY_ENABLE;
+    if (ret == 0)
+    {
+      ret = ilps28qsw_cfg_write(ctx, ILPS28QSW_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+    }
+  }
+
+  bus_unlock(ctx);
+
+  return ret;
+}
+
+/*
+ * ODR period in 1/256 us (1000000 * 256 / ODR), 0 in one-shot mode.
+ */
+static uint32_t odr_period_q8(ilps28qsw_md_t *md)
+{
+  static const uint32_t period[9] =
+  {
+    0U, 256000000U, 64000000U, 25600000U, 10240000U,
+    5120000U, 3413333U, 2560000U, 1280000U,
+  };
+
+  return ((uint8_t)md->odr > 8U) ? 0U : period[(uint8_t)md->odr];
+}
+
+/*
+ * Period between FIFO entries in 1/256 us, 0 in one-shot mode.
+ */
+static uint32_t fifo_entry_period_q8(ilps28qsw_md_t *md)
+{
+  uint32_t period = odr_period_q8(md);
+
+  if (md->interleaved_mode == 1U)
+  {
+    period /= ILPS28QSW_INTERLEAVED_ENTRIES;
+  }
+
+  return period;
+}
+
+/**
+  * @brief  Typical conversion time of one sample.[get]
+  *
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @retval       conversion time in us
+  *
+  */
+uint32_t ilps28qsw_conv_time_us(ilps28qsw_md_t *md)
+{
+  /* 1.5 ms + 125 us per averaged sample */
+  static const uint32_t conv[8] =
+  {
+    2000U, 2500U, 3500U, 5500U, 9500U, 17500U, 33500U, 65500U,
+  };
+
+  return conv[(uint8_t)md->avg & 0x07U];
+}
+
+/**
+  * @brief  Start a one-shot conversion.
+  *         The trigger is written from the cached CTRL_REG2 if the
+  *         shadow registers are enabled.
+  *
+  * @param  ctx      communication interface handler.(ptr)
+  * @param  md       the sensor conversion parameters.(ptr)
+  * @param  wait_us  time to wait before fetching the sample (us).(ptr)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_one_shot_start(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                                 uint32_t *wait_us)
+{
+  int32_t ret;
+
+  bus_lock(ctx);
+  ret = ilps28qsw_trigger_sw(ctx, md);
+  *wait_us = ilps28qsw_conv_time_us(md);
+
+  bus_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  AH/QVAR function enable.[set]
+  *
+  * @param  ctx    Read / write interface definitions
+  * @param  val    Change the value of ah_qvar_en in reg CTRL_REG3
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t ilps28qsw_ah_qvar_en_set(stmdev_ctx_t *ctx, uint8_t val)
+{
+  ilps28qsw_ctrl_reg3_t ctrl_reg3;
+  int32_t ret;
+
+  bus_lock(ctx);
+  ret = ilps28qsw_cfg_read(ctx, ILPS28QSW_CTRL_REG3, (uint8_t *)&ctrl_reg3, 1);
+
+  if (ret == 0)
+  {
+    ctrl_reg3.ah_qvar_en = val;
+    ret = ilps28qsw_cfg_write(ctx, ILPS28QSW_CTRL_REG3, (uint8_t *)&ctrl_reg3, 1);
+  }
+
+  bus_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  AH/QVAR function enable.[get]
+  *
+  * @param  ctx    Read / write interface definitions
+  * @param  val    Return the value of ah_qvar_en in reg CTRL_REG3
+  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  *
+  */
+int32_t ilps28qsw_ah_qvar_en_get(stmdev_ctx_t *ctx, uint8_t *val)
+{
+  ilps28qsw_ctrl_reg3_t ctrl_reg3;
+  int32_t ret;
+
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_CTRL_REG3, (uint8_t *)&ctrl_reg3, 1);
+  *val = ctrl_reg3.ah_qvar_en;
+
+  return ret;
+}
+
+/**
+  * @brief  Software trigger for One-Shot.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  data  data retrived from the sensor.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_data_get(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                           ilps28qsw_data_t *data)
+{
+  uint8_t buff[5];
+  int32_t ret;
+
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_PRESS_OUT_XL, buff, 5);
+  data_decode(md, buff, data);
+
+  return ret;
+}
+
+/**
+  * @brief  Read a one-shot sample with one burst from STATUS.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  data  data retrived from the sensor, valid if ready.(ptr)
+  * @param  ready 1 -> new pressure sample, 0 -> conversion not complete.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_one_shot_fetch(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                                 ilps28qsw_data_t *data, uint8_t *ready)
+{
+  ilps28qsw_status_t status;
+  uint8_t buff[6];
+  int32_t ret;
+
+  *ready = PROPERTY_DISABLE;
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_STATUS, buff, 6);
+  if (ret == 0)
+  {
+    bytecpy((uint8_t *)&status, &buff[0]);
+    if (status.p_da == PROPERTY_ENABLE)
+    {
+      data_decode(md, &buff[1], data);
+      *ready = PROPERTY_ENABLE;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  One-shot acquisition: trigger, sleep for the conversion time
+  *         through ctx->mdelay and read the sample, polling at 1 ms
+  *         up to ILPS28QSW_ONE_SHOT_RETRY times if not yet available.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  data  data retrived from the sensor, valid if ready.(ptr)
+  * @param  ready 1 -> new pressure sample, 0 -> conversion not complete.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_one_shot_get(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                               ilps28qsw_data_t *data, uint8_t *ready)
+{
+  uint32_t wait_us;
+  uint8_t retry = 0U;
+  int32_t ret;
+
+  *ready = PROPERTY_DISABLE;
+  ret = ilps28qsw_one_shot_start(ctx, md, &wait_us);
+  if (ret == 0)
+  {
+    if (ctx->mdelay != NULL)
+    {
+      ctx->mdelay((wait_us + 999U) / 1000U);
+    }
+    ret = ilps28qsw_one_shot_fetch(ctx, md, data, ready);
+  }
+
+  while ((ret == 0) && (*ready == PROPERTY_DISABLE) &&
+         (ctx->mdelay != NULL) && (retry < ILPS28QSW_ONE_SHOT_RETRY))
+  {
+    ctx->mdelay(1U);
+    retry++;
+    ret = ilps28qsw_one_shot_fetch(ctx, md, data, ready);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Output data read with integer conversion (no float).[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  data  data retrived from the sensor.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_data_fixed_get(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                                 ilps28qsw_data_fixed_t *data)
+{
+  uint8_t buff[5];
+  int32_t ret;
+
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_PRESS_OUT_XL, buff, 5);
+
+  /* pressure conversion */
+  data->pressure.raw = (int32_t)buff[2];
+  data->pressure.raw = (data->pressure.raw * 256) + (int32_t) buff[1];
+  data->pressure.raw = (data->pressure.raw * 256) + (int32_t) buff[0];
+  data->pressure.raw = data->pressure.raw * 256;
+
+  data->pressure.cpa = 0;
+  data->ah_qvar.lsb = 0;
+  if ((md->interleaved_mode == 1U) && ((buff[0] & 0x1U) != 0U))
+  {
+    /* data is a AH_QVAR sample */
+    data->ah_qvar.lsb = (data->pressure.raw / 256); /* shift 8bit left */
+  }
+  else if (md->fs == ILPS28QSW_4060hPa)
+  {
+    data->pressure.cpa = ilps28qsw_from_fs4000_to_cPa(data->pressure.raw);
+  }
+  else
+  {
+    data->pressure.cpa = ilps28qsw_from_fs1260_to_cPa(data->pressure.raw);
+  }
+
+  /* temperature conversion */
+  data->heat.raw = (int16_t)buff[4];
+  data->heat.raw = (data->heat.raw * 256) + (int16_t) buff[3];
+  data->heat.cdeg_c = ilps28qsw_from_lsb_to_cdeg_c(data->heat.raw);
+
+  return ret;
+}
+
+/**
+  * @brief  AH/QVAR data read.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  data  data retrived from the sensor.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_ah_qvar_data_get(stmdev_ctx_t *ctx,
+                                   ilps28qsw_ah_qvar_data_t *data)
+{
+  uint8_t buff[3];
+  int32_t ret;
+
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_PRESS_OUT_XL, buff, 3);
+
+  /* QVAR conversion */
+  data->raw = (int32_t)buff[2];
+  data->raw = (data->raw * 256) + (int32_t) buff[1];
+  data->raw = (data->raw * 256) + (int32_t) buff[0];
+  data->raw = (data->raw * 256);
+  data->lsb = (data->raw / 256); /* shift 8bit left */
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     FIFO functions
+  * @brief        This section groups all the functions concerning the
+  *               management of FIFO.
+  * @{
+  *
+  */
+
+/**
+  * @brief  FIFO operation mode selection.[set]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  val   set the FIFO operation mode.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_fifo_mode_set(stmdev_ctx_t *ctx, ilps28qsw_fifo_md_t *val)
+{
+  ilps28qsw_fifo_ctrl_t fifo_ctrl;
+  ilps28qsw_fifo_wtm_t fifo_wtm;
+  uint8_t reg[2];
+  int32_t ret;
+
+  bus_lock(ctx);
+  ret = ilps28qsw_cfg_read(ctx, ILPS28QSW_FIFO_CTRL, reg, 2);
+  if (ret == 0)
+  {
+    bytecpy((uint8_t *)&fifo_ctrl, &reg[0]);
+    bytecpy((uint8_t *)&fifo_wtm, &reg[1]);
+
+    fifo_ctrl.f_mode = (uint8_t)val->operation & 0x03U;
+    fifo_ctrl.trig_modes = ((uint8_t)val->operation & 0x04U) >> 2;
+
+    if (val->watermark != 0x00U)
+    {
+      fifo_ctrl.stop_on_wtm = PROPERTY_ENABLE;
+    }
+    else
+    {
+      fifo_ctrl.stop_on_wtm = PROPERTY_DISABLE;
+    }
+
+    fifo_wtm.wtm = val->watermark;
+
+    bytecpy(&reg[0], (uint8_t *)&fifo_ctrl);
+    bytecpy(&reg[1], (uint8_t *)&fifo_wtm);
+
+    ret = ilps28qsw_cfg_write(ctx, ILPS28QSW_FIFO_CTRL, reg, 2);
+  }
+
+  bus_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO operation mode selection.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  val   get the FIFO operation mode.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_fifo_mode_get(stmdev_ctx_t *ctx, ilps28qsw_fifo_md_t *val)
+{
+  ilps28qsw_fifo_ctrl_t fifo_ctrl;
+  ilps28qsw_fifo_wtm_t fifo_wtm;
+  uint8_t reg[2];
+  int32_t ret;
+
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_FIFO_CTRL, reg, 2);
+
+  bytecpy((uint8_t *)&fifo_ctrl, &reg[0]);
+  bytecpy((uint8_t *)&fifo_wtm, &reg[1]);
+
+  switch ((fifo_ctrl.trig_modes << 2) | fifo_ctrl.f_mode)
+  {
+    case ILPS28QSW_BYPASS:
+      val->operation = ILPS28QSW_BYPASS;
+      break;
+    case ILPS28QSW_FIFO:
+      val->operation = ILPS28QSW_FIFO;
+      break;
+    case ILPS28QSW_STREAM:
+      val->operation = ILPS28QSW_STREAM;
+      break;
+    case ILPS28QSW_STREAM_TO_FIFO:
+      val->operation = ILPS28QSW_STREAM_TO_FIFO;
+      break;
+    case ILPS28QSW_BYPASS_TO_STREAM:
+      val->operation = ILPS28QSW_BYPASS_TO_STREAM;
+      break;
+    case ILPS28QSW_BYPASS_TO_FIFO:
+      val->operation = ILPS28QSW_BYPASS_TO_FIFO;
+      break;
+    default:
+      val->operation = ILPS28QSW_BYPASS;
+      break;
+  }
+
+  val->watermark = fifo_wtm.wtm;
+
+  return ret;
+}
+
+/**
+  * @brief  Get the number of samples stored in FIFO.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  val   number of samples stored in FIFO.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_fifo_level_get(stmdev_ctx_t *ctx, uint8_t *val)
+{
+  ilps28qsw_fifo_status1_t fifo_status1;
+  int32_t ret;
+
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_FIFO_STATUS1,
+                           (uint8_t *)&fifo_status1, 1);
+
+  *val = fifo_status1.fss;
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO raw data read with burst transactions.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  samp  number of samples to read from FIFO.
+  * @param  buff  buffer of (3 * samp) bytes that stores raw FIFO data.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_fifo_raw_data_get(stmdev_ctx_t *ctx, uint8_t samp,
+                                    uint8_t *buff)
+{
+  uint16_t burst = fifo_burst_max(ctx);
+  uint16_t left = samp;
+  uint16_t idx = 0U;
+  uint16_t chunk;
+  int32_t ret = 0;
+
+  /* FIFO_DATA_OUT address rolls back to PRESS_XL: one read, many samples */
+  while ((left > 0U) && (ret == 0))
+  {
+    chunk = (left > burst) ? burst : left;
+    ret = ilps28qsw_read_reg(ctx, ILPS28QSW_FIFO_DATA_OUT_PRESS_XL, &buff[idx],
+                             chunk * ILPS28QSW_FIFO_SAMPLE_LEN);
+    idx += chunk * ILPS28QSW_FIFO_SAMPLE_LEN;
+    left -= chunk;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Convert FIFO raw data retrieved by ilps28qsw_fifo_raw_data_get.
+  *
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  buff  buffer of (3 * samp) bytes of raw FIFO data.(ptr)
+  * @param  samp  number of samples stored in buff.
+  * @param  data  converted FIFO data.(ptr)
+  *
+  */
+void ilps28qsw_fifo_data_decode(ilps28qsw_md_t *md, const uint8_t *buff,
+                                uint8_t samp, ilps28qsw_fifo_data_t *data)
+{
+  const uint8_t *fifo_data;
+  uint8_t i;
+
+  for (i = 0U; i < samp; i++)
+  {
+    fifo_data = &buff[(uint16_t)i * ILPS28QSW_FIFO_SAMPLE_LEN];
+    data[i].raw = (int32_t)fifo_data[2];
+    data[i].raw = (data[i].raw * 256) + (int32_t)fifo_data[1];
+    data[i].raw = (data[i].raw * 256) + (int32_t)fifo_data[0];
+    data[i].raw = (data[i].raw * 256);
+
+    if (md->interleaved_mode == 1U)
+    {
+      if ((fifo_data[0] & 0x1U) == 0U)
+      {
+        /* data is a pressure sample */
+        switch (md->fs)
+        {
+          case ILPS28QSW_1260hPa:
+            data[i].hpa = ilps28qsw_from_fs1260_to_hPa(data[i].raw);
+            break;
+          case ILPS28QSW_4060hPa:
+            data[i].hpa = ilps28qsw_from_fs4000_to_hPa(data[i].raw);
+            break;
+          default:
+            data[i].hpa = 0.0f;
+            break;
+        }
+        data[i].lsb = 0;
+      }
+      else
+      {
+        /* data is a AH_QVAR sample */
+        data[i].lsb = (data[i].raw / 256); /* shift 8bit left */
+        data[i].hpa = 0.0f;
+      }
+    }
+    else
+    {
+      switch (md->fs)
+      {
+        case ILPS28QSW_1260hPa:
+          data[i].hpa = ilps28qsw_from_fs1260_to_hPa(data[i].raw);
+          break;
+        case ILPS28QSW_4060hPa:
+          data[i].hpa = ilps28qsw_from_fs4000_to_hPa(data[i].raw);
+          break;
+        default:
+          data[i].hpa = 0.0f;
+          break;
+      }
+      data[i].lsb = 0;
+    }
+  }
+}
+
+/**
+  * @brief  Convert FIFO raw data with integer arithmetic (no float).
+  *
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  buff  buffer of (3 * samp) bytes of raw FIFO data.(ptr)
+  * @param  samp  number of samples stored in buff.
+  * @param  data  converted FIFO data.(ptr)
+  *
+  */
+void ilps28qsw_fifo_data_fixed_decode(ilps28qsw_md_t *md, const uint8_t *buff,
+                                      uint8_t samp,
+                                      ilps28qsw_fifo_data_fixed_t *data)
+{
+  const uint8_t *fifo_data;
+  uint8_t i;
+
+  for (i = 0U; i < samp; i++)
+  {
+    fifo_data = &buff[(uint16_t)i * ILPS28QSW_FIFO_SAMPLE_LEN];
+    data[i].raw = (int32_t)fifo_data[2];
+    data[i].raw = (data[i].raw * 256) + (int32_t)fifo_data[1];
+    data[i].raw = (data[i].raw * 256) + (int32_t)fifo_data[0];
+    data[i].raw = (data[i].raw * 256);
+
+    data[i].cpa = 0;
+    data[i].lsb = 0;
+    if ((md->interleaved_mode == 1U) && ((fifo_data[0] & 0x1U) != 0U))
+    {
+      /* data is a AH_QVAR sample */
+      data[i].lsb = (data[i].raw / 256); /* shift 8bit left */
+    }
+    else if (md->fs == ILPS28QSW_4060hPa)
+    {
+      data[i].cpa = ilps28qsw_from_fs4000_to_cPa(data[i].raw);
+    }
+    else
+    {
+      data[i].cpa = ilps28qsw_from_fs1260_to_cPa(data[i].raw);
+    }
+  }
+}
+
+/**
+  * @brief  Pack FIFO raw data into compact samples.
+  *         Samples are processed from the last one, so buff may be the
+  *         same memory as data (in place expansion from 3 to 4 bytes).
+  *
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  buff  buffer of (3 * samp) bytes of raw FIFO data.(ptr)
+  * @param  samp  number of samples stored in buff.
+  * @param  data  compact FIFO samples.(ptr)
+  *
+  */
+void ilps28qsw_fifo_sample_pack(ilps28qsw_md_t *md, const uint8_t *buff,
+                                uint8_t samp, ilps28qsw_fifo_sample_t *data)
+{
+  const uint8_t *fifo_data;
+  ilps28qsw_fifo_sample_t val;
+  uint8_t i = samp;
+
+  while (i > 0U)
+  {
+    i--;
+    fifo_data = &buff[(uint16_t)i * ILPS28QSW_FIFO_SAMPLE_LEN];
+    val = ((uint32_t)fifo_data[2] << 16) | ((uint32_t)fifo_data[1] << 8) |
+          (uint32_t)fifo_data[0];
+    if ((md->interleaved_mode == 1U) && ((fifo_data[0] & 0x1U) != 0U))
+    {
+      val |= ILPS28QSW_FIFO_SAMPLE_QVAR;
+    }
+    data[i] = val;
+  }
+}
+
+/**
+  * @brief  FIFO data read into compact samples, 4 bytes each.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  samp  number of samples stored in FIFO.
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  data  compact FIFO samples, also used as burst buffer.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_fifo_sample_get(stmdev_ctx_t *ctx, uint8_t samp,
+                                  ilps28qsw_md_t *md,
+                                  ilps28qsw_fifo_sample_t *data)
+{
+  int32_t ret;
+
+  ret = ilps28qsw_fifo_raw_data_get(ctx, samp, (uint8_t *)data);
+  ilps28qsw_fifo_sample_pack(md, (uint8_t *)data, samp, data);
+
+  return ret;
+}
+
+/**
+  * @brief  Check if a compact sample is an AH_QVAR sample.
+  *
+  * @param  val   compact FIFO sample.
+  * @retval       1 for AH_QVAR samples, 0 for pressure samples
+  *
+  */
+uint8_t ilps28qsw_fifo_sample_is_qvar(ilps28qsw_fifo_sample_t val)
+{
+  return ((val & ILPS28QSW_FIFO_SAMPLE_QVAR) != 0U) ? 1U : 0U;
+}
+
+/**
+  * @brief  Compact sample as 32 bit signed-left aligned raw value.
+  *
+  * @param  val   compact FIFO sample.
+  * @retval       raw value, same format of ilps28qsw_fifo_data_t.raw
+  *
+  */
+int32_t ilps28qsw_fifo_sample_raw(ilps28qsw_fifo_sample_t val)
+{
+  return (int32_t)((val & 0x00FFFFFFU) << 8);
+}
+
+/**
+  * @brief  Compact sample pressure in hPa (0 for AH_QVAR samples).
+  *
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  val   compact FIFO sample.
+  * @retval       pressure in hPa
+  *
+  */
+float_t ilps28qsw_fifo_sample_to_hPa(ilps28qsw_md_t *md,
+                                     ilps28qsw_fifo_sample_t val)
+{
+  float_t hpa = 0.0f;
+
+  if ((val & ILPS28QSW_FIFO_SAMPLE_QVAR) == 0U)
+  {
+    if (md->fs == ILPS28QSW_4060hPa)
+    {
+      hpa = ilps28qsw_from_fs4000_to_hPa(ilps28qsw_fifo_sample_raw(val));
+    }
+    else
+    {
+      hpa = ilps28qsw_from_fs1260_to_hPa(ilps28qsw_fifo_sample_raw(val));
+    }
+  }
+
+  return hpa;
+}
+
+/**
+  * @brief  Compact sample pressure in 0.01 Pa (0 for AH_QVAR samples).
+  *
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  val   compact FIFO sample.
+  * @retval       pressure in 0.01 Pa
+  *
+  */
+int32_t ilps28qsw_fifo_sample_to_cPa(ilps28qsw_md_t *md,
+                                     ilps28qsw_fifo_sample_t val)
+{
+  int32_t cpa = 0;
+
+  if ((val & ILPS28QSW_FIFO_SAMPLE_QVAR) == 0U)
+  {
+    if (md->fs == ILPS28QSW_4060hPa)
+    {
+      cpa = ilps28qsw_from_fs4000_to_cPa(ilps28qsw_fifo_sample_raw(val));
+    }
+    else
+    {
+      cpa = ilps28qsw_from_fs1260_to_cPa(ilps28qsw_fifo_sample_raw(val));
+    }
+  }
+
+  return cpa;
+}
+
+/**
+  * @brief  Compact sample AH_QVAR value (0 for pressure samples).
+  *
+  * @param  val   compact FIFO sample.
+  * @retval       AH_QVAR, 24 bit properly right aligned
+  *
+  */
+int32_t ilps28qsw_fifo_sample_to_qvar(ilps28qsw_fifo_sample_t val)
+{
+  int32_t lsb = 0;
+
+  if ((val & ILPS28QSW_FIFO_SAMPLE_QVAR) != 0U)
+  {
+    lsb = ilps28qsw_fifo_sample_raw(val) / 256;
+  }
+
+  return lsb;
+}
+
+/**
+  * @brief  Initialize the interleaved mode demultiplexer.
+  *
+  * @param  dmx   demultiplexer state.(ptr)
+  *
+  */
+void ilps28qsw_demux_init(ilps28qsw_demux_t *dmx)
+{
+  dmx->press_seq = 0U;
+  dmx->qvar_seq = 0U;
+  dmx->lost = 0U;
+  dmx->last = 0U;
+}
+
+/**
+  * @brief  Split interleaved FIFO raw data into pressure and AH_QVAR
+  *         streams with a single pass.
+  *
+  * @param  dmx    demultiplexer state.(ptr)
+  * @param  buff   buffer of (3 * samp) bytes of raw FIFO data.(ptr)
+  * @param  samp   number of samples stored in buff.
+  * @param  press  pressure stream destination.(ptr)
+  * @param  qvar   AH_QVAR stream destination.(ptr)
+  * @retval        number of samples consumed from buff (less than samp
+  *                when a destination is full)
+  *
+  */
+uint16_t ilps28qsw_fifo_demux(ilps28qsw_demux_t *dmx, const uint8_t *buff,
+                              uint16_t samp, ilps28qsw_demux_stream_t *press,
+                              ilps28qsw_demux_stream_t *qvar)
+{
+  ilps28qsw_demux_stream_t *dst;
+  const uint8_t *fifo_data;
+  uint32_t *seq;
+  uint32_t *other;
+  int32_t raw;
+  uint16_t i;
+  uint8_t tag;
+
+  press->count = 0U;
+  qvar->count = 0U;
+
+  for (i = 0U; i < samp; i++)
+  {
+    fifo_data = &buff[(uint32_t)i * ILPS28QSW_FIFO_SAMPLE_LEN];
+    raw = (int32_t)(((uint32_t)fifo_data[2] << 24) |
+                    ((uint32_t)fifo_data[1] << 16) |
+                    ((uint32_t)fifo_data[0] << 8));
+
+    if ((fifo_data[0] & 0x1U) == 0U)
+    {
+      tag = 1U;
+      dst = press;
+      seq = &dmx->press_seq;
+      other = &dmx->qvar_seq;
+    }
+    else
+    {
+      tag = 2U;
+      dst = qvar;
+      seq = &dmx->qvar_seq;
+      other = &dmx->press_seq;
+      raw = raw / 256;
+    }
+
+    if (dst->count >= dst->max)
+    {
+      break;
+    }
+
+    if (tag == dmx->last)
+    {
+      /* same stream twice: the other stream missed its sample */
+      *other += 1U;
+      dmx->lost++;
+    }
+    dmx->last = tag;
+
+    dst->val[dst->count] = raw;
+    if (dst->seq != NULL)
+    {
+      dst->seq[dst->count] = *seq;
+    }
+    dst->count++;
+    *seq += 1U;
+  }
+
+  return i;
+}
+
+/*
+ * Assemble raw FIFO samples as 32 bit signed-left aligned values.
+ */
+static void fifo_batch_raw(const uint8_t *buff, uint16_t samp, int32_t *raw)
+{
+  uint16_t i = 0U;
+
+#if defined(ILPS28QSW_USE_SSSE3) && defined(__SSSE3__)
+  const __m128i mask = _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5,
+                                     -1, 6, 7, 8, -1, 9, 10, 11);
+  __m128i v;
+
+  /* 4 samples per step, 16 bytes load: keep 6 samples of margin */
+  while ((uint32_t)i + 6U <= (uint32_t)samp)
+  {
+    v = _mm_loadu_si128((const __m128i *)&buff[(uint32_t)i * 3U]);
+    _mm_storeu_si128((__m128i *)&raw[i], _mm_shuffle_epi8(v, mask));
+    i += 4U;
+  }
+#endif /* ILPS28QSW_USE_SSSE3 */
+
+  for (; i < samp; i++)
+  {
+    raw[i] = (int32_t)(((uint32_t)buff[(uint32_t)i * 3U + 2U] << 24) |
+                       ((uint32_t)buff[(uint32_t)i * 3U + 1U] << 16) |
+                       ((uint32_t)buff[(uint32_t)i * 3U] << 8));
+  }
+}
+
+/**
+  * @brief  Convert FIFO raw data into separate arrays. Full scale and
+  *         interleaved mode are resolved once, so every pass is a plain
+  *         loop the compiler can vectorize.
+  *
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  buff  buffer of (3 * samp) bytes of raw FIFO data.(ptr)
+  * @param  samp  number of samples stored in buff.
+  * @param  raw   32 bit signed-left aligned samples, samp items.(ptr)
+  * @param  hpa   pressure in hPa, samp items, NULL to skip. AH_QVAR
+  *               samples are set to 0.(ptr)
+  * @param  qvar  AH_QVAR 24 bit right aligned, samp items, NULL to skip.
+  *               Pressure samples are set to 0.(ptr)
+  *
+  */
+void ilps28qsw_fifo_batch_decode(ilps28qsw_md_t *md, const uint8_t *buff,
+                                 uint16_t samp, int32_t *raw, float_t *hpa,
+                                 int32_t *qvar)
+{
+  float_t sens;
+  uint16_t i;
+
+  fifo_batch_raw(buff, samp, raw);
+
+  /* 1 / (4096.0f * 256) or 1 / (2048.0f * 256): exact as powers of two */
+  sens = (md->fs == ILPS28QSW_4060hPa) ? (1.0f / 524288.0f) :
+         (1.0f / 1048576.0f);
+
+  if (md->interleaved_mode == 1U)
+  {
+    /* bit 0 of PRESS_XL (bit 8 of raw) tags AH_QVAR samples */
+    if (hpa != NULL)
+    {
+      for (i = 0U; i < samp; i++)
+      {
+        hpa[i] = ((raw[i] & 0x100) == 0) ? ((float_t)raw[i] * sens) : 0.0f;
+      }
+    }
+    if (qvar != NULL)
+    {
+      for (i = 0U; i < samp; i++)
+      {
+        qvar[i] = ((raw[i] & 0x100) != 0) ? (raw[i] / 256) : 0;
+      }
+    }
+  }
+  else
+  {
+    if (hpa != NULL)
+    {
+      for (i = 0U; i < samp; i++)
+      {
+        hpa[i] = (float_t)raw[i] * sens;
+      }
+    }
+    if (qvar != NULL)
+    {
+      for (i = 0U; i < samp; i++)
+      {
+        qvar[i] = 0;
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Initialize the altitude stage: no offset, references and
+  *         statistics cleared.
+  *
+  * @param  alt   altitude stage.(ptr)
+  * @param  md    the sensor conversion parameters.(ptr)
+  *
+  */
+void ilps28qsw_alt_init(ilps28qsw_alt_t *alt, ilps28qsw_md_t *md)
+{
+  alt->offset = 0;
+  alt->ref_q12 = 0;
+  alt->ref_mm = 0;
+  alt->n = 0U;
+  alt->sum = 0;
+  alt->sumsq = 0;
+  alt->fs_4060 = (md->fs == ILPS28QSW_4060hPa) ? 1U : 0U;
+  alt->interleaved = md->interleaved_mode;
+}
+
+/**
+  * @brief  Load the one-point calibration value (RPDS, hPa * 16 at
+  *         1260 hPa or hPa * 8 at 4060 hPa full scale) as the pressure
+  *         offset subtracted by the altitude stage.
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  alt   altitude stage.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_alt_opc_load(stmdev_ctx_t *ctx, ilps28qsw_alt_t *alt)
+{
+  int16_t opc;
+  int32_t ret;
+
+  ret = ilps28qsw_opc_get(ctx, &opc);
+  if (ret == 0)
+  {
+    alt->offset = -((int32_t)opc * ((alt->fs_4060 != 0U) ? 512 : 256));
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Altitude from pressure, interpolation error lower than 0.15 m
+  *         above 600 hPa and 0.07 m above 900 hPa.
+  *
+  * @param  q12   pressure in hPa Q12, clamped to 256 .. 1280 hPa.
+  * @retval       altitude in mm
+  *
+  */
+int32_t ilps28qsw_alt_from_q12(int32_t q12)
+{
+  /* mm, pressure from 256 hPa to 1280 hPa in steps of 8 hPa */
+  static const int32_t lut[129] =
+  {
+    10209312, 10008955, 9813456, 9622558, 9436027, 9253645,
+    9075212, 8900542, 8729461, 8561809, 8397437, 8236203,
+    8077978, 7922638, 7770069, 7620162, 7472816, 7327935,
+    7185429, 7045212, 6907204, 6771329, 6637514, 6505690,
+    6375794, 6247762, 6121537, 5997061, 5874282, 5753150,
+    5633614, 5515630, 5399153, 5284140, 5170551, 5058347,
+    4947491, 4837948, 4729682, 4622662, 4516856, 4412232,
+    4308763, 4206420, 4105176, 4005005, 3905882, 3807783,
+    3710684, 3614563, 3519398, 3425169, 3331854, 3239434,
+    3147891, 3057206, 2967360, 2878338, 2790122, 2702696,
+    2616045, 2530153, 2445005, 2360588, 2276888, 2193890,
+    2111582, 2029952, 1948987, 1868675, 1789003, 1709962,
+    1631540, 1553727, 1476511, 1399882, 1323831, 1248349,
+    1173425, 1099050, 1025216, 951915, 879136, 806873,
+    735116, 663859, 593093, 522811, 453006, 383670,
+    314797, 246379, 178411, 110884, 43794, -22866,
+    -89103, -154922, -220330, -285331, -349932, -414137,
+    -477953, -541384, -604436, -667114, -729422, -791366,
+    -852950, -914179, -975057, -1035589, -1095779, -1155632,
+    -1215151, -1274342, -1333207, -1391751, -1449977, -1507890,
+    -1565494, -1622791, -1679786, -1736482, -1792882, -1848991,
+    -1904811, -1960345, -2015598,
+  };
+  int32_t idx;
+  int32_t frac;
+
+  if (q12 < (256 * 4096))
+  {
+    q12 = 256 * 4096;
+  }
+  else if (q12 >= (1280 * 4096))
+  {
+    q12 = (1280 * 4096) - 1;
+  }
+  else
+  {
+    /* in range */
+  }
+
+  /* 8 hPa = 2^15 */
+  idx = (q12 / 32768) - 32;
+  frac = q12 % 32768;
+
+  return lut[idx] + (int32_t)((((int64_t)lut[idx + 1] - lut[idx]) * frac) /
+                              32768);
+}
+
+/**
+  * @brief  Set the reference of altitude and pressure deltas.
+  *
+  * @param  alt   altitude stage.(ptr)
+  * @param  lsb   reference pressure, 24 bit right aligned raw value.
+  *
+  */
+void ilps28qsw_alt_reference_set(ilps28qsw_alt_t *alt, int32_t lsb)
+{
+  alt->ref_q12 = ((alt->fs_4060 != 0U) ? (lsb * 2) : lsb) + alt->offset;
+  alt->ref_mm = ilps28qsw_alt_from_q12(alt->ref_q12);
+}
+
+/**
+  * @brief  One pass over raw FIFO data (ilps28qsw_fifo_raw_data_get):
+  *         altitude and pressure delta relative to the reference, running
+  *         statistics updated. AH_QVAR samples are skipped.
+  *
+  * @param  alt     altitude stage.(ptr)
+  * @param  buff    buffer of (3 * samp) bytes of raw FIFO data.(ptr)
+  * @param  samp    number of samples in buff.
+  * @param  alt_mm  relative altitude in mm, NULL to skip.(ptr)
+  * @param  delta   pressure delta in hPa Q12, NULL to skip.(ptr)
+  * @retval         number of pressure samples
+  *
+  */
+uint16_t ilps28qsw_alt_batch(ilps28qsw_alt_t *alt, const uint8_t *buff,
+                             uint16_t samp, int32_t *alt_mm, int32_t *delta)
+{
+  const uint8_t *b;
+  uint32_t u;
+  int32_t q12;
+  int32_t h;
+  uint16_t n = 0U;
+  uint16_t i;
+
+  for (i = 0U; i < samp; i++)
+  {
+    b = &buff[i * ILPS28QSW_FIFO_SAMPLE_LEN];
+    if ((alt->interleaved == 0U) || ((b[0] & 0x01U) == 0U))
+    {
+      u = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16);
+      q12 = (int32_t)(u << 8) / 256;
+      q12 = ((alt->fs_4060 != 0U) ? (q12 * 2) : q12) + alt->offset;
+      h = ilps28qsw_alt_from_q12(q12) - alt->ref_mm;
+
+      if (alt_mm != NULL)
+      {
+        alt_mm[n] = h;
+      }
+      if (delta != NULL)
+      {
+        delta[n] = q12 - alt->ref_q12;
+      }
+
+      alt->n++;
+      alt->sum += h;
+      alt->sumsq += (int64_t)h * h;
+      n++;
+    }
+  }
+
+  return n;
+}
+
+/**
+  * @brief  Running mean and variance of relative altitude.[get]
+  *
+  * @param  alt   altitude stage.(ptr)
+  * @param  mean  mean in mm.(ptr)
+  * @param  var   variance in mm^2, saturated.(ptr)
+  *
+  */
+void ilps28qsw_alt_stats_get(ilps28qsw_alt_t *alt, int32_t *mean,
+                             uint32_t *var)
+{
+  int64_t m = 0;
+  int64_t v = 0;
+
+  if (alt->n > 0U)
+  {
+    m = alt->sum / (int64_t)alt->n;
+    v = (alt->sumsq / (int64_t)alt->n) - (m * m);
+  }
+
+  *mean = (int32_t)m;
+  *var = (v > 0xFFFFFFFF) ? 0xFFFFFFFFU : ((v > 0) ? (uint32_t)v : 0U);
+}
+
+/**
+  * @brief  Start a telemetry stream: reset the delta streams and write the
+  *         header.
+  *
+  * @param  tlm   telemetry encoder.(ptr)
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  hdr   ILPS28QSW_TLM_HDR_LEN bytes of header.(ptr)
+  *
+  */
+void ilps28qsw_tlm_enc_init(ilps28qsw_tlm_t *tlm, ilps28qsw_md_t *md,
+                            uint8_t *hdr)
+{
+  tlm->last[0] = 0;
+  tlm->last[1] = 0;
+  tlm->interleaved = md->interleaved_mode & 0x01U;
+
+  hdr[0] = (uint8_t)(ILPS28QSW_TLM_VERSION << 4) |
+           (uint8_t)(tlm->interleaved << 1) |
+           (((uint8_t)md->fs == (uint8_t)ILPS28QSW_4060hPa) ? 1U : 0U);
+  hdr[1] = (uint8_t)(((uint8_t)md->avg & 0x07U) << 4) |
+           ((uint8_t)md->odr & 0x0FU);
+  hdr[2] = (uint8_t)md->lpf & 0x03U;
+}
+
+/**
+  * @brief  Encode raw FIFO samples, as many as fit in the output buffer.
+  *         Can be called on each FIFO burst of the stream.
+  *
+  * @param  tlm   telemetry encoder.(ptr)
+  * @param  buff  buffer of (3 * samp) bytes of raw FIFO data.(ptr)
+  * @param  samp  number of samples stored in buff.
+  * @param  out   encoded data.(ptr)
+  * @param  len   size of out, ILPS28QSW_TLM_SAMPLE_MAX * samp bytes always
+  *               fit.
+  * @param  used  bytes written in out.(ptr)
+  * @retval       number of samples encoded
+  *
+  */
+uint16_t ilps28qsw_tlm_encode(ilps28qsw_tlm_t *tlm, const uint8_t *buff,
+                              uint16_t samp, uint8_t *out, uint16_t len,
+                              uint16_t *used)
+{
+  const uint8_t *b;
+  uint32_t code;
+  uint32_t c;
+  int32_t val;
+  int32_t d;
+  uint16_t n = 0U;
+  uint16_t i;
+  uint8_t tag = 0U;
+  uint8_t k;
+
+  for (i = 0U; i < samp; i++)
+  {
+    b = &buff[(uint32_t)i * ILPS28QSW_FIFO_SAMPLE_LEN];
+    val = (int32_t)(((uint32_t)b[2] << 24) | ((uint32_t)b[1] << 16) |
+                    ((uint32_t)b[0] << 8)) / 256;
+    if (tlm->interleaved == 1U)
+    {
+      /* bit 0 of PRESS_XL tags AH_QVAR samples */
+      tag = b[0] & 0x01U;
+      val = (val - (int32_t)tag) / 2;
+    }
+
+    d = val - tlm->last[tag];
+    code = (d >= 0) ? ((uint32_t)d << 1) : ((((uint32_t)(-(d + 1))) << 1) | 1U);
+    if (tlm->interleaved == 1U)
+    {
+      code = (code << 1) | tag;
+    }
+
+    k = 1U;
+    for (c = code >> 7; c != 0U; c >>= 7)
+    {
+      k++;
+    }
+    if ((uint16_t)(len - n) < k)
+    {
+      break;
+    }
+
+    while (code > 0x7FU)
+    {
+      out[n] = (uint8_t)(code & 0x7FU) | 0x80U;
+      code >>= 7;
+      n++;
+    }
+    out[n] = (uint8_t)code;
+    n++;
+
+    tlm->last[tag] = val;
+  }
+
+  *used = n;
+
+  return i;
+}
+
+/**
+  * @brief  Start decoding a telemetry stream from its header.
+  *
+  * @param  tlm   telemetry decoder.(ptr)
+  * @param  hdr   ILPS28QSW_TLM_HDR_LEN bytes of header.(ptr)
+  * @param  md    the sensor conversion parameters of the stream.(ptr)
+  * @retval       0 -> no Error, -1 -> unknown version or invalid header
+  *
+  */
+int32_t ilps28qsw_tlm_dec_init(ilps28qsw_tlm_t *tlm, const uint8_t *hdr,
+                               ilps28qsw_md_t *md)
+{
+  int32_t ret = 0;
+
+  if (((hdr[0] >> 4) != ILPS28QSW_TLM_VERSION) ||
+      ((hdr[1] & 0x0FU) > (uint8_t)ILPS28QSW_200Hz) ||
+      ((hdr[2] & 0x03U) == 2U))
+  {
+    ret = -1;
+  }
+  else
+  {
+    tlm->last[0] = 0;
+    tlm->last[1] = 0;
+    tlm->interleaved = (hdr[0] >> 1) & 0x01U;
+
+    md->fs = ((hdr[0] & 0x01U) == 1U) ? ILPS28QSW_4060hPa : ILPS28QSW_1260hPa;
+    md->interleaved_mode = tlm->interleaved;
+    /* header fields carry the enum values */
+    md->odr = hdr[1] & 0x0FU;
+    md->avg = (hdr[1] >> 4) & 0x07U;
+    md->lpf = hdr[2] & 0x03U;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Decode telemetry data back to raw FIFO samples. A sample
+  *         truncated at the end of in is left for the next call.
+  *
+  * @param  tlm      telemetry decoder.(ptr)
+  * @param  in       encoded data, following the header.(ptr)
+  * @param  len      number of bytes in in.
+  * @param  buff     buffer of (3 * samp) bytes of raw FIFO data.(ptr)
+  * @param  samp     maximum number of samples to decode.
+  * @param  decoded  number of samples decoded.(ptr)
+  * @param  used     bytes consumed from in, corrupted varint included.(ptr)
+  * @retval          0 -> no Error, -1 -> varint longer than
+  *                  ILPS28QSW_TLM_SAMPLE_MAX bytes (corrupted data): the
+  *                  delta streams are lost, restart from the next header
+  *
+  */
+int32_t ilps28qsw_tlm_decode(ilps28qsw_tlm_t *tlm, const uint8_t *in,
+                             uint16_t len, uint8_t *buff, uint16_t samp,
+                             uint16_t *decoded, uint16_t *used)
+{
+  uint8_t *b;
+  uint32_t code;
+  uint32_t u;
+  int32_t val;
+  uint16_t pos = 0U;
+  uint16_t n = 0U;
+  uint16_t k;
+  uint8_t tag = 0U;
+  uint8_t sh;
+  int32_t ret = 0;
+
+  while (n < samp)
+  {
+    code = 0U;
+    sh = 0U;
+    k = pos;
+    while ((k < len) && ((in[k] & 0x80U) != 0U) &&
+           (sh < (7U * (ILPS28QSW_TLM_SAMPLE_MAX - 1U))))
+    {
+      code |= (uint32_t)(in[k] & 0x7FU) << sh;
+      sh += 7U;
+      k++;
+    }
+    if (k >= len)
+    {
+      /* truncated varint, left for the next call */
+      break;
+    }
+    if ((in[k] & 0x80U) != 0U)
+    {
+      /* overlong varint: skip it up to its last byte */
+      while ((k < len) && ((in[k] & 0x80U) != 0U))
+      {
+        k++;
+      }
+      pos = (k < len) ? (k + 1U) : k;
+      ret = -1;
+      break;
+    }
+    code |= (uint32_t)in[k] << sh;
+    pos = k + 1U;
+
+    if (tlm->interleaved == 1U)
+    {
+      tag = (uint8_t)(code & 0x01U);
+      code >>= 1;
+    }
+
+    val = ((code & 0x01U) == 0U) ? (int32_t)(code >> 1) :
+          (-(int32_t)(code >> 1) - 1);
+    val += tlm->last[tag];
+    tlm->last[tag] = val;
+
+    if (tlm->interleaved == 1U)
+    {
+      val = (val * 2) + (int32_t)tag;
+    }
+
+    u = (uint32_t)val;
+    b = &buff[(uint32_t)n * ILPS28QSW_FIFO_SAMPLE_LEN];
+    b[0] = (uint8_t)u;
+    b[1] = (uint8_t)(u >> 8);
+    b[2] = (uint8_t)(u >> 16);
+    n++;
+  }
+
+  *decoded = n;
+  *used = pos;
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO data read.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  samp  number of samples stored in FIFO.
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  data  data retrived from FIFO.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_fifo_data_get(stmdev_ctx_t *ctx, uint8_t samp,
+                                ilps28qsw_md_t *md, ilps28qsw_fifo_data_t *data)
+{
+  uint8_t fifo_data[ILPS28QSW_FIFO_DATA_CHUNK * ILPS28QSW_FIFO_SAMPLE_LEN];
+  uint8_t chunk;
+  uint8_t i = 0U;
+  int32_t ret = 0;
+
+  while ((i < samp) && (ret == 0))
+  {
+    chunk = samp - i;
+    if (chunk > ILPS28QSW_FIFO_DATA_CHUNK)
+    {
+      chunk = (uint8_t)ILPS28QSW_FIFO_DATA_CHUNK;
+    }
+
+    ret = ilps28qsw_fifo_raw_data_get(ctx, chunk, fifo_data);
+    ilps28qsw_fifo_data_decode(md, fifo_data, chunk, &data[i]);
+    i += chunk;
   }
-  if (ret == 0)
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO data read with integer conversion (no float).[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  samp  number of samples stored in FIFO.
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  data  data retrived from FIFO.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_fifo_data_fixed_get(stmdev_ctx_t *ctx, uint8_t samp,
+                                      ilps28qsw_md_t *md,
+                                      ilps28qsw_fifo_data_fixed_t *data)
+{
+  uint8_t fifo_data[ILPS28QSW_FIFO_DATA_CHUNK * ILPS28QSW_FIFO_SAMPLE_LEN];
+  uint8_t chunk;
+  uint8_t i = 0U;
+  int32_t ret = 0;
+
+  while ((i < samp) && (ret == 0))
   {
-    ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INTERRUPT_CFG,
-                             (uint8_t *)&interrupt_cfg, 1);
+    chunk = samp - i;
+    if (chunk > ILPS28QSW_FIFO_DATA_CHUNK)
+    {
+      chunk = (uint8_t)ILPS28QSW_FIFO_DATA_CHUNK;
+    }
+
+    ret = ilps28qsw_fifo_raw_data_get(ctx, chunk, fifo_data);
+    ilps28qsw_fifo_data_fixed_decode(md, fifo_data, chunk, &data[i]);
+    i += chunk;
   }
-  val->sw_reset  = ctrl_reg2.swreset;
-  val->boot      = int_source.boot_on;
-  val->drdy_pres = status.p_da;
-  val->drdy_temp = status.t_da;
-  val->ovr_pres  = status.p_or;
-  val->ovr_temp  = status.t_or;
-  val->end_meas  = ~ctrl_reg2.oneshot;
-  val->ref_done = ~interrupt_cfg.autozero;
 
   return ret;
 }
 
 /**
-  * @brief  Electrical pin configuration.[set]
+  * @brief  Initialize an empty samples ring.
+  *
+  * @param  ring  samples ring.(ptr)
+  *
+  */
+void ilps28qsw_ring_init(ilps28qsw_ring_t *ring)
+{
+  ring->head = 0U;
+  ring->tail = 0U;
+}
+
+/**
+  * @brief  Number of samples stored in the ring.
+  *
+  * @param  ring  samples ring.(ptr)
+  * @retval       number of samples ready to be popped
+  *
+  */
+uint16_t ilps28qsw_ring_count(ilps28qsw_ring_t *ring)
+{
+  return (uint16_t)(ring->head - ring->tail);
+}
+
+/**
+  * @brief  Push samples into the ring (producer side).
+  *
+  * @param  ring  samples ring.(ptr)
+  * @param  data  samples to push.(ptr)
+  * @param  n     number of samples to push.
+  * @retval       number of samples pushed (less than n if ring is full)
+  *
+  */
+uint16_t ilps28qsw_ring_push(ilps28qsw_ring_t *ring,
+                             const ilps28qsw_fifo_sample_t *data, uint16_t n)
+{
+  uint16_t head = ring->head;
+  uint16_t num;
+  uint16_t i;
+
+  num = (uint16_t)ILPS28QSW_RING_SIZE - (uint16_t)(head - ring->tail);
+  if (num > n)
+  {
+    num = n;
+  }
+
+  for (i = 0U; i < num; i++)
+  {
+    ring->buf[(uint16_t)(head + i) & (ILPS28QSW_RING_SIZE - 1U)] = data[i];
+  }
+
+  /* publish data before index */
+  ILPS28QSW_RING_BARRIER();
+  ring->head = head + num;
+
+  return num;
+}
+
+/**
+  * @brief  Pop samples from the ring (consumer side).
+  *
+  * @param  ring  samples ring.(ptr)
+  * @param  data  buffer that receives the samples.(ptr)
+  * @param  n     max number of samples to pop.
+  * @retval       number of samples popped
+  *
+  */
+uint16_t ilps28qsw_ring_pop(ilps28qsw_ring_t *ring,
+                            ilps28qsw_fifo_sample_t *data, uint16_t n)
+{
+  uint16_t tail = ring->tail;
+  uint16_t num;
+  uint16_t i;
+
+  num = (uint16_t)(ring->head - tail);
+  if (num > n)
+  {
+    num = n;
+  }
+
+  /* read index before data */
+  ILPS28QSW_RING_BARRIER();
+  for (i = 0U; i < num; i++)
+  {
+    data[i] = ring->buf[(uint16_t)(tail + i) & (ILPS28QSW_RING_SIZE - 1U)];
+  }
+
+  /* release slots after data are read */
+  ILPS28QSW_RING_BARRIER();
+  ring->tail = tail + num;
+
+  return num;
+}
+
+/**
+  * @brief  FIFO data read straight into the samples ring (producer side,
+  *         usable from ISR). Samples not fitting the ring are left
+  *         in the device FIFO. If the read of the second (wrapped)
+  *         segment fails, the first one is still stored.
+  *
+  * @param  ctx     communication interface handler.(ptr)
+  * @param  samp    number of samples to read from FIFO.
+  * @param  md      the sensor conversion parameters.(ptr)
+  * @param  ring    samples ring.(ptr)
+  * @param  stored  number of samples moved into the ring.(ptr)
+  * @retval         interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_fifo_ring_drain(stmdev_ctx_t *ctx, uint8_t samp,
+                                  ilps28qsw_md_t *md, ilps28qsw_ring_t *ring,
+                                  uint8_t *stored)
+{
+  uint16_t head = ring->head;
+  uint16_t idx = head & (ILPS28QSW_RING_SIZE - 1U);
+  uint16_t num;
+  uint16_t seg;
+  int32_t ret = 0;
+
+  num = (uint16_t)ILPS28QSW_RING_SIZE - (uint16_t)(head - ring->tail);
+  if (num > samp)
+  {
+    num = samp;
+  }
+
+  /* burst read in place: up to two contiguous segments of the ring */
+  seg = (uint16_t)ILPS28QSW_RING_SIZE - idx;
+  if (seg > num)
+  {
+    seg = num;
+  }
+  if (seg > 0U)
+  {
+    ret = ilps28qsw_fifo_sample_get(ctx, (uint8_t)seg, md, &ring->buf[idx]);
+  }
+  if (ret != 0)
+  {
+    num = 0U;
+  }
+  else if (num > seg)
+  {
+    ret = ilps28qsw_fifo_sample_get(ctx, (uint8_t)(num - seg), md,
+                                    &ring->buf[0]);
+    if (ret != 0)
+    {
+      /* first segment already popped from FIFO: keep it */
+      num = seg;
+    }
+  }
+
+  /* publish data before index */
+  ILPS28QSW_RING_BARRIER();
+  ring->head = head + num;
+  *stored = (uint8_t)num;
+
+  return ret;
+}
+
+/*
+ * Read FIFO_STATUS1 and FIFO_STATUS2 with a single transaction.
+ */
+static int32_t fifo_srv_status(stmdev_ctx_t *ctx, ilps28qsw_fifo_srv_t *val)
+{
+  ilps28qsw_fifo_status2_t fifo_status2;
+  uint8_t reg[2];
+  int32_t ret;
+
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_FIFO_STATUS1, reg, 2);
+  bytecpy((uint8_t *)&fifo_status2, &reg[1]);
+
+  val->level     = reg[0];
+  val->stored    = 0U;
+  val->fifo_th   = fifo_status2.fifo_wtm_ia;
+  val->fifo_ovr  = fifo_status2.fifo_ovr_ia;
+  val->fifo_full = fifo_status2.fifo_full_ia;
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO service: read level and flags, then drain the stored
+  *         samples (two transactions up to ILPS28QSW_FIFO_BURST_MAX).[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  data  compact FIFO samples.(ptr)
+  * @param  max   max number of samples stored in data.
+  * @param  val   FIFO level, flags and number of samples read.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_fifo_service(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                               ilps28qsw_fifo_sample_t *data, uint8_t max,
+                               ilps28qsw_fifo_srv_t *val)
+{
+  uint8_t samp;
+  int32_t ret;
+
+  ret = fifo_srv_status(ctx, val);
+
+  samp = (val->level > max) ? max : val->level;
+  if ((ret == 0) && (samp > 0U))
+  {
+    ret = ilps28qsw_fifo_sample_get(ctx, samp, md, data);
+    if (ret == 0)
+    {
+      val->stored = samp;
+    }
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  FIFO service into the samples ring (producer side, usable
+  *         from ISR).[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  ring  samples ring.(ptr)
+  * @param  val   FIFO level, flags and number of samples read.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_fifo_ring_service(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                                    ilps28qsw_ring_t *ring,
+                                    ilps28qsw_fifo_srv_t *val)
+{
+  int32_t ret;
+
+  ret = fifo_srv_status(ctx, val);
+
+  if ((ret == 0) && (val->level > 0U))
+  {
+    ret = ilps28qsw_fifo_ring_drain(ctx, val->level, md, ring, &val->stored);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Event service, e.g. on INT pin or I3C in-band interrupt: one
+  *         snapshot (sources, FIFO level, last sample) and, if FIFO is
+  *         not empty, drain of the stored samples into the ring.
+  *
+  * @param  ctx     communication interface handler.(ptr)
+  * @param  md      the sensor conversion parameters.(ptr)
+  * @param  ring    destination of the FIFO samples, NULL to skip.(ptr)
+  * @param  snap    sources, FIFO level and output data.(ptr)
+  * @param  stored  number of samples pushed in the ring.(ptr)
+  * @retval         interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_event_service(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                                ilps28qsw_ring_t *ring,
+                                ilps28qsw_poll_snapshot_t *snap,
+                                uint8_t *stored)
+{
+  int32_t ret;
+
+  *stored = 0U;
+  ret = ilps28qsw_poll_snapshot_get(ctx, md, snap);
+
+  if ((ret == 0) && (ring != NULL) && (snap->fifo_level > 0U))
+  {
+    ret = ilps28qsw_fifo_ring_drain(ctx, snap->fifo_level, md, ring, stored);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Initialize FIFO samples timestamping.
+  *
+  * @param  ts     timestamping state.(ptr)
+  * @param  md     the sensor conversion parameters.(ptr)
+  * @param  shift  drift estimation smoothing, new estimate weights 1/2^shift.
+  * @retval        0 -> no Error, -1 -> ODR not suitable (one-shot)
+  *
+  */
+int32_t ilps28qsw_ts_init(ilps28qsw_ts_t *ts, ilps28qsw_md_t *md,
+                          uint8_t shift)
+{
+  int32_t ret = 0;
+
+  if (fifo_entry_period_q8(md) == 0U)
+  {
+    ret = -1;
+  }
+  else
+  {
+    /* interleaved mode: pressure and AH_QVAR entries share FIFO */
+    ts->nominal = fifo_entry_period_q8(md);
+    ts->period = ts->nominal;
+    ts->last_ts = 0U;
+    ts->pending = 0U;
+    ts->valid = 0U;
+    ts->shift = (shift > 15U) ? 15U : shift;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Assign a host timestamp to every sample of a FIFO batch and
+  *         refine the period estimate.
+  *
+  * @param  ts      timestamping state.(ptr)
+  * @param  irq_ts  host time (us) of the FIFO interrupt.
+  * @param  ref     index in the batch of the sample which raised the
+  *                 interrupt (e.g. watermark - 1).
+  * @param  samp    number of samples in the batch.
+  * @param  stamp   host time (us) of each sample, NULL to skip.(ptr)
+  *
+  */
+void ilps28qsw_ts_batch(ilps28qsw_ts_t *ts, uint32_t irq_ts, uint8_t ref,
+                        uint8_t samp, uint32_t *stamp)
+{
+  uint32_t entries;
+  int64_t meas;
+  int64_t t;
+  uint8_t i;
+
+  if (ref >= samp)
+  {
+    ref = (samp > 0U) ? (samp - 1U) : 0U;
+  }
+
+  entries = (uint32_t)ts->pending + ref + 1U;
+  if ((ts->valid != 0U) && (samp > 0U))
+  {
+    meas = ((int64_t)(uint32_t)(irq_ts - ts->last_ts) * 256) / entries;
+
+    /* discard estimates off by more than 1/8 (missed interrupt, overrun) */
+    if ((meas > ((int64_t)ts->nominal - (ts->nominal / 8U))) &&
+        (meas < ((int64_t)ts->nominal + (ts->nominal / 8U))))
+    {
+      t = (int64_t)ts->period;
+      t += (meas - t) / ((int64_t)1 << ts->shift);
+      ts->period = (uint32_t)t;
+    }
+  }
+
+  if (samp > 0U)
+  {
+    ts->last_ts = irq_ts;
+    ts->pending = (uint16_t)(samp - ref - 1U);
+    ts->valid = 1U;
+  }
+
+  if (stamp != NULL)
+  {
+    for (i = 0U; i < samp; i++)
+    {
+      t = ((int64_t)i - ref) * (int64_t)ts->period;
+      stamp[i] = irq_ts + (uint32_t)(int32_t)(t / 256);
+    }
+  }
+}
+
+/**
+  * @brief  Sensor ODR drift against the host clock.
+  *
+  * @param  ts    timestamping state.(ptr)
+  * @retval       drift in ppm, positive when the sensor is slower
+  *
+  */
+int32_t ilps28qsw_ts_drift_ppm(ilps28qsw_ts_t *ts)
+{
+  return (int32_t)((((int64_t)ts->period - ts->nominal) * 1000000) /
+                   ts->nominal);
+}
+
+/**
+  * @brief  Initialize the watermark scheduler.
+  *
+  * @param  sched       watermark scheduler state.(ptr)
+  * @param  latency_us  max delay allowed from conversion to host (us).
+  * @param  wake_us     host wake-up and FIFO service cost (us).
+  *
+  */
+void ilps28qsw_wtm_sched_init(ilps28qsw_wtm_sched_t *sched,
+                              uint32_t latency_us, uint32_t wake_us)
+{
+  sched->latency_us = latency_us;
+  sched->wake_us = wake_us;
+  sched->clean = 0U;
+  sched->margin = 1U;
+  sched->watermark = 0U;
+}
+
+/**
+  * @brief  Compute the watermark for the current mode and program FIFO.
+  *         The FIFO runs in stream mode with stop_on_wtm disabled, so all
+  *         the FIFO depth above watermark absorbs the host wake-up time.
+  *         In interleaved mode latency and room are counted on the FIFO
+  *         entry period (pressure and AH_QVAR entries share FIFO).
+  *         In one-shot mode FIFO is set in bypass.
+  *
+  * @param  ctx    communication interface handler.(ptr)
+  * @param  sched  watermark scheduler state.(ptr)
+  * @param  md     the sensor conversion parameters.(ptr)
+  * @retval        interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_wtm_sched_apply(stmdev_ctx_t *ctx,
+                                  ilps28qsw_wtm_sched_t *sched,
+                                  ilps28qsw_md_t *md)
+{
+  ilps28qsw_fifo_ctrl_t fifo_ctrl;
+  ilps28qsw_fifo_wtm_t fifo_wtm;
+  uint32_t period = fifo_entry_period_q8(md) >> 8;
+  uint32_t conv;
+  uint32_t lat;
+  uint32_t room;
+  uint32_t wtm;
+  uint8_t reg[2];
+  int32_t ret;
+
+  if (period == 0U)
+  {
+    wtm = 0U;
+  }
+  else
+  {
+    conv = ilps28qsw_conv_time_us(md);
+
+    /* the first entry of a batch waits watermark - 1 entry periods */
+    lat = sched->latency_us;
+    lat = (lat > (sched->wake_us + conv)) ?
+          (lat - sched->wake_us - conv) : 0U;
+    wtm = (lat / period) + 1U;
+
+    /* entries stored while the host wakes up must still fit in FIFO */
+    room = (sched->wake_us + period - 1U) / period;
+    room = 128U - ((room + sched->margin < 127U) ?
+                   (room + sched->margin) : 127U);
+    wtm = (wtm > sched->margin) ? (wtm - sched->margin) : 1U;
+    wtm = (wtm < room) ? wtm : room;
+    wtm = (wtm < 127U) ? wtm : 127U;
+  }
+
+  bus_lock(ctx);
+  ret = ilps28qsw_cfg_read(ctx, ILPS28QSW_FIFO_CTRL, reg, 2);
+  if (ret == 0)
+  {
+    bytecpy((uint8_t *)&fifo_ctrl, &reg[0]);
+    bytecpy((uint8_t *)&fifo_wtm, &reg[1]);
+
+    fifo_ctrl.f_mode = (wtm != 0U) ? ((uint8_t)ILPS28QSW_STREAM & 0x03U) :
+                       ((uint8_t)ILPS28QSW_BYPASS & 0x03U);
+    fifo_ctrl.trig_modes = PROPERTY_DISABLE;
+    fifo_ctrl.stop_on_wtm = PROPERTY_DISABLE;
+    fifo_wtm.wtm = (uint8_t)wtm;
+
+    bytecpy(&reg[0], (uint8_t *)&fifo_ctrl);
+    bytecpy(&reg[1], (uint8_t *)&fifo_wtm);
+
+    ret = ilps28qsw_cfg_write(ctx, ILPS28QSW_FIFO_CTRL, reg, 2);
+  }
+
+  if (ret == 0)
+  {
+    sched->watermark = (uint8_t)wtm;
+  }
+
+  bus_unlock(ctx);
+
+  return ret;
+}
+
+/**
+  * @brief  Re-tune the watermark from the outcome of a FIFO service.
+  *         A miss increases the margin at once, a long run of clean
+  *         batches gives one entry back.
   *
-  * @param  ctx   communication interface handler.(ptr)
-  * @param  val   the electrical settings for the configurable pins.(ptr)
-  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  * @param  ctx    communication interface handler.(ptr)
+  * @param  sched  watermark scheduler state.(ptr)
+  * @param  md     the sensor conversion parameters.(ptr)
+  * @param  ovr    FIFO overrun or full seen on service.
+  * @param  late   batch delivered after the latency budget.
+  * @retval        interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t ilps28qsw_pin_conf_set(stmdev_ctx_t *ctx, ilps28qsw_pin_conf_t *val)
+int32_t ilps28qsw_wtm_sched_feedback(stmdev_ctx_t *ctx,
+                                     ilps28qsw_wtm_sched_t *sched,
+                                     ilps28qsw_md_t *md, uint8_t ovr,
+                                     uint8_t late)
 {
-  ilps28qsw_if_ctrl_t if_ctrl;
-  int32_t ret;
+  uint8_t margin = sched->margin;
+  int32_t ret = 0;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_IF_CTRL, (uint8_t *)&if_ctrl, 1);
+  if ((ovr != 0U) || (late != 0U))
+  {
+    sched->clean = 0U;
+    margin = (margin < (ILPS28QSW_WTM_MARGIN_MAX / 2U)) ?
+             (margin * 2U) : (uint8_t)ILPS28QSW_WTM_MARGIN_MAX;
+  }
+  else if (sched->clean < ILPS28QSW_WTM_RELAX)
+  {
+    sched->clean++;
+  }
+  else
+  {
+    sched->clean = 0U;
+    margin = (margin > 1U) ? (margin - 1U) : 1U;
+  }
 
-  if (ret == 0)
+  if (margin != sched->margin)
   {
-    if_ctrl.sda_pu_en = val->sda_pull_up;
-    ret = ilps28qsw_write_reg(ctx, ILPS28QSW_IF_CTRL, (uint8_t *)&if_ctrl, 1);
+    sched->margin = margin;
+    ret = ilps28qsw_wtm_sched_apply(ctx, sched, md);
   }
 
   return ret;
 }
 
 /**
-  * @brief  Electrical pin configuration.[get]
+  * @brief  Initialize the multi-device manager.
   *
-  * @param  ctx   communication interface handler.(ptr)
-  * @param  val   the electrical settings for the configurable pins.(ptr)
-  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  * @param  mgr     multi-device manager.(ptr)
+  * @param  policy  ILPS28QSW_MGR_ROUND_ROBIN or ILPS28QSW_MGR_DEADLINE.
   *
   */
-int32_t ilps28qsw_pin_conf_get(stmdev_ctx_t *ctx, ilps28qsw_pin_conf_t *val)
+void ilps28qsw_mgr_init(ilps28qsw_mgr_t *mgr, uint8_t policy)
 {
-  ilps28qsw_if_ctrl_t if_ctrl;
-  int32_t ret;
-
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_IF_CTRL, (uint8_t *)&if_ctrl, 1);
+  uint8_t i;
 
-  val->sda_pull_up  = if_ctrl.sda_pu_en;
+  mgr->count = 0U;
+  for (i = 0U; i < ILPS28QSW_MGR_BUS_MAX; i++)
+  {
+    mgr->next[i] = 0U;
+  }
 
-  return ret;
+  if (policy == (uint8_t)ILPS28QSW_MGR_DEADLINE)
+  {
+    mgr->policy = ILPS28QSW_MGR_DEADLINE;
+  }
+  else
+  {
+    mgr->policy = ILPS28QSW_MGR_ROUND_ROBIN;
+  }
 }
 
 /**
-  * @brief  Get the status of all the interrupt sources.[get]
+  * @brief  Register a device. It must be configured (mode and FIFO)
+  *         before its first service.
   *
-  * @param  ctx   communication interface handler.(ptr)
-  * @param  val   the status of all the interrupt sources.(ptr)
-  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  * @param  mgr     multi-device manager.(ptr)
+  * @param  ctx     communication interface handler of the device.(ptr)
+  * @param  md      the sensor conversion parameters.(ptr)
+  * @param  ring    destination of the FIFO samples.(ptr)
+  * @param  bus     physical bus, less than ILPS28QSW_MGR_BUS_MAX.
+  * @param  period  service period without interrupt (us), 0 on interrupt
+  *                 only.
+  * @retval         device index, -1 -> manager full or bad bus
   *
   */
-int32_t ilps28qsw_all_sources_get(stmdev_ctx_t *ctx,
-                                  ilps28qsw_all_sources_t *val)
+int32_t ilps28qsw_mgr_add(ilps28qsw_mgr_t *mgr, stmdev_ctx_t *ctx,
+                          ilps28qsw_md_t *md, ilps28qsw_ring_t *ring,
+                          uint8_t bus, uint32_t period)
 {
-  ilps28qsw_fifo_status2_t fifo_status2;
-  ilps28qsw_int_source_t int_source;
-  ilps28qsw_status_t status;
-  int32_t ret;
+  ilps28qsw_mgr_dev_t *dev;
+  int32_t ret = -1;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_STATUS, (uint8_t *)&status, 1);
-  if (ret == 0)
+  if ((mgr->count < ILPS28QSW_MGR_MAX) && (bus < ILPS28QSW_MGR_BUS_MAX))
   {
-    ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INT_SOURCE,
-                             (uint8_t *)&int_source, 1);
+    dev = &mgr->dev[mgr->count];
+    dev->ctx = ctx;
+    dev->md = *md;
+    dev->ring = ring;
+    dev->srv.level = 0U;
+    dev->srv.stored = 0U;
+    dev->srv.fifo_th = 0U;
+    dev->srv.fifo_ovr = 0U;
+    dev->srv.fifo_full = 0U;
+    dev->period = period;
+    dev->deadline = 0U;
+    dev->bus = bus;
+    dev->pending = 0U;
+    ret = (int32_t)mgr->count;
+    mgr->count++;
   }
-  if (ret == 0)
+
+  return ret;
+}
+
+/**
+  * @brief  Notify the FIFO interrupt of a device, safe from interrupt
+  *         handlers.
+  *
+  * @param  mgr   multi-device manager.(ptr)
+  * @param  idx   device index.
+  *
+  */
+void ilps28qsw_mgr_notify(ilps28qsw_mgr_t *mgr, uint8_t idx)
+{
+  if (idx < mgr->count)
   {
-    ret = ilps28qsw_read_reg(ctx, ILPS28QSW_FIFO_STATUS2,
-                             (uint8_t *)&fifo_status2, 1);
+    mgr->dev[idx].pending = PROPERTY_ENABLE;
   }
+}
 
-  val->drdy_pres        = status.p_da;
-  val->drdy_temp        = status.t_da;
-  val->over_pres        = int_source.ph;
-  val->under_pres       = int_source.pl;
-  val->thrsld_pres      = int_source.ia;
-  val->fifo_full        = fifo_status2.fifo_full_ia;
-  val->fifo_ovr         = fifo_status2.fifo_ovr_ia;
-  val->fifo_th          = fifo_status2.fifo_wtm_ia;
-
-  return ret;
+/*
+ * Device needing service: interrupt notified or service period elapsed.
+ */
+static uint8_t mgr_due(ilps28qsw_mgr_dev_t *dev, uint32_t now)
+{
+  return ((dev->pending != 0U) ||
+          ((dev->period != 0U) && ((int32_t)(now - dev->deadline) >= 0))) ?
+         1U : 0U;
 }
 
+/*
+ * Deadline of a due device, pending devices are due now at the latest.
+ */
+static uint32_t mgr_deadline(ilps28qsw_mgr_dev_t *dev, uint32_t now)
+{
+  uint32_t deadline = dev->deadline;
+
+  if ((dev->pending != 0U) && ((int32_t)(now - deadline) < 0))
+  {
+    deadline = now;
+  }
+
+  return deadline;
+}
 
 /**
-  * @brief  Sensor conversion parameters selection.[set]
+  * @brief  Drain the FIFO of one device of a bus into its ring, chosen
+  *         in turn or by earliest deadline among the pending and due
+  *         devices. Call it in loop from the task owning the bus.
   *
-  * @param  ctx   communication interface handler.(ptr)
-  * @param  val   set the sensor conversion parameters.(ptr)
+  * @param  mgr   multi-device manager.(ptr)
+  * @param  bus   physical bus.
+  * @param  now   host time (us).
+  * @param  idx   device serviced, -1 if none.(ptr)
   * @retval       interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t ilps28qsw_mode_set(stmdev_ctx_t *ctx, ilps28qsw_md_t *val)
+int32_t ilps28qsw_mgr_service(ilps28qsw_mgr_t *mgr, uint8_t bus,
+                              uint32_t now, int32_t *idx)
 {
-  ilps28qsw_ctrl_reg1_t ctrl_reg1;
-  ilps28qsw_ctrl_reg2_t ctrl_reg2;
-  ilps28qsw_ctrl_reg3_t ctrl_reg3;
-  ilps28qsw_fifo_ctrl_t fifo_ctrl;
-  uint8_t odr_save = 0, ah_qvar_en_save = 0;
-  uint8_t reg[3];
-  int32_t ret;
-
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_CTRL_REG1, reg, 3);
+  ilps28qsw_mgr_dev_t *dev;
+  int32_t ret = 0;
+  int32_t sel = -1;
+  uint8_t start;
+  uint8_t i;
+  uint8_t n;
 
-  if (ret == 0)
+  if ((bus < ILPS28QSW_MGR_BUS_MAX) && (mgr->count > 0U))
   {
-    bytecpy((uint8_t *)&ctrl_reg1, &reg[0]);
-    bytecpy((uint8_t *)&ctrl_reg2, &reg[1]);
-    bytecpy((uint8_t *)&ctrl_reg3, &reg[2]);
+    start = (mgr->next[bus] < mgr->count) ? mgr->next[bus] : 0U;
 
-    /* handle interleaved mode setting */
-    if (ctrl_reg1.odr != 0x0U)
+    for (n = 0U; n < mgr->count; n++)
     {
-      /* power-down */
-      odr_save = ctrl_reg1.odr;
-      ctrl_reg1.odr = 0x0U;
-      ret += ilps28qsw_write_reg(ctx, ILPS28QSW_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
+      i = (uint8_t)((start + n) % mgr->count);
+      dev = &mgr->dev[i];
+
+      if ((dev->bus == bus) && (mgr_due(dev, now) != 0U))
+      {
+        if (mgr->policy == ILPS28QSW_MGR_ROUND_ROBIN)
+        {
+          sel = (int32_t)i;
+          break;
+        }
+        /* ties keep the round-robin order */
+        if ((sel < 0) ||
+            ((int32_t)(mgr_deadline(dev, now) -
+                       mgr_deadline(&mgr->dev[sel], now)) < 0))
+        {
+          sel = (int32_t)i;
+        }
+      }
     }
 
-    if (ctrl_reg3.ah_qvar_en != 0U)
+    if (sel >= 0)
     {
-      /* disable QVAR */
-      ah_qvar_en_save = ctrl_reg3.ah_qvar_en;
-      ctrl_reg3.ah_qvar_en = 0;
-      ret += ilps28qsw_write_reg(ctx, ILPS28QSW_CTRL_REG3, (uint8_t *)&ctrl_reg3, 1);
+      dev = &mgr->dev[sel];
+      dev->pending = 0U;
+      dev->deadline = now + dev->period;
+      mgr->next[bus] = (uint8_t)((uint8_t)sel + 1U);
+      ret = ilps28qsw_fifo_ring_service(dev->ctx, &dev->md, dev->ring,
+                                        &dev->srv);
     }
+  }
 
-    /* set interleaved mode (0 or 1) */
-    ctrl_reg3.ah_qvar_p_auto_en = val->interleaved_mode;
-    ret += ilps28qsw_write_reg(ctx, ILPS28QSW_CTRL_REG3, (uint8_t *)&ctrl_reg3, 1);
+  *idx = sel;
 
-    /* set FIFO interleaved mode (0 or 1) */
-    ret += ilps28qsw_read_reg(ctx, ILPS28QSW_FIFO_CTRL, (uint8_t *)&fifo_ctrl, 1);
-    fifo_ctrl.ah_qvar_p_fifo_en = val->interleaved_mode;
-    ret += ilps28qsw_write_reg(ctx, ILPS28QSW_FIFO_CTRL, (uint8_t *)&fifo_ctrl, 1);
+  return ret;
+}
 
-    if (ah_qvar_en_save != 0U)
-    {
-      /* restore ah_qvar_en back to previous setting */
-      ctrl_reg3.ah_qvar_en = ah_qvar_en_save;
-    }
+/**
+  * @brief  Poll all the devices of a bus, or of all buses with
+  *         ILPS28QSW_MGR_ALL_BUSES, one snapshot each.[get]
+  *
+  * @param  mgr   multi-device manager.(ptr)
+  * @param  bus   physical bus or ILPS28QSW_MGR_ALL_BUSES.
+  * @param  val   one snapshot per device, by device index.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_mgr_poll(ilps28qsw_mgr_t *mgr, uint8_t bus,
+                           ilps28qsw_poll_snapshot_t *val)
+{
+  ilps28qsw_mgr_dev_t *dev;
+  int32_t ret = 0;
+  uint8_t i;
 
-    if (odr_save != 0U)
+  for (i = 0U; i < mgr->count; i++)
+  {
+    dev = &mgr->dev[i];
+    if ((bus == ILPS28QSW_MGR_ALL_BUSES) || (dev->bus == bus))
     {
-      /* restore odr back to previous setting */
-      ctrl_reg1.odr = odr_save;
+      ret += ilps28qsw_poll_snapshot_get(dev->ctx, &dev->md, &val[i]);
     }
-
-    ctrl_reg1.odr = (uint8_t)val->odr;
-    ctrl_reg1.avg = (uint8_t)val->avg;
-    ctrl_reg2.en_lpfp = (uint8_t)val->lpf & 0x01U;
-    ctrl_reg2.lfpf_cfg = ((uint8_t)val->lpf & 0x02U) >> 2;
-    ctrl_reg2.fs_mode = (uint8_t)val->fs;
-
-    bytecpy(&reg[0], (uint8_t *)&ctrl_reg1);
-    bytecpy(&reg[1], (uint8_t *)&ctrl_reg2);
-    bytecpy(&reg[2], (uint8_t *)&ctrl_reg3);
-    ret += ilps28qsw_write_reg(ctx, ILPS28QSW_CTRL_REG1, reg, 3);
   }
 
   return ret;
 }
 
 /**
-  * @brief  Sensor conversion parameters selection.[get]
+  * @brief  Arm a triggered capture: FIFO content is cleared through
+  *         bypass mode and the trigger mode is set.
   *
   * @param  ctx   communication interface handler.(ptr)
-  * @param  val   get the sensor conversion parameters.(ptr)
+  * @param  cap   capture state, fifo set by the caller.(ptr)
   * @retval       interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t ilps28qsw_mode_get(stmdev_ctx_t *ctx, ilps28qsw_md_t *val)
+int32_t ilps28qsw_capture_arm(stmdev_ctx_t *ctx, ilps28qsw_capture_t *cap)
 {
-  ilps28qsw_ctrl_reg1_t ctrl_reg1;
-  ilps28qsw_ctrl_reg2_t ctrl_reg2;
-  ilps28qsw_ctrl_reg3_t ctrl_reg3;
-  uint8_t reg[3];
+  ilps28qsw_fifo_md_t bypass;
   int32_t ret;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_CTRL_REG1, reg, 3);
+  bus_lock(ctx);
+  bypass.operation = ILPS28QSW_BYPASS;
+  bypass.watermark = cap->fifo.watermark;
 
+  ret = ilps28qsw_fifo_mode_set(ctx, &bypass);
   if (ret == 0)
   {
-    bytecpy((uint8_t *)&ctrl_reg1, &reg[0]);
-    bytecpy((uint8_t *)&ctrl_reg2, &reg[1]);
-    bytecpy((uint8_t *)&ctrl_reg3, &reg[2]);
+    ret = ilps28qsw_fifo_mode_set(ctx, &cap->fifo);
+  }
 
-    switch (ctrl_reg2.fs_mode)
-    {
-      case ILPS28QSW_1260hPa:
-        val->fs = ILPS28QSW_1260hPa;
-        break;
-      case ILPS28QSW_4060hPa:
-        val->fs = ILPS28QSW_4060hPa;
-        break;
-      default:
-        val->fs = ILPS28QSW_1260hPa;
-        break;
-    }
+  cap->pre = ((uint8_t)cap->fifo.operation == (uint8_t)ILPS28QSW_STREAM_TO_FIFO) ?
+             ILPS28QSW_CAPTURE_PRE_UNKNOWN : 0U;
+  cap->level = 0U;
+  cap->triggered = 0U;
 
-    switch (ctrl_reg1.odr)
-    {
-      case ILPS28QSW_ONE_SHOT:
-        val->odr = ILPS28QSW_ONE_SHOT;
-        break;
-      case ILPS28QSW_1Hz:
-        val->odr = ILPS28QSW_1Hz;
-        break;
-      case ILPS28QSW_4Hz:
-        val->odr = ILPS28QSW_4Hz;
-        break;
-      case ILPS28QSW_10Hz:
-        val->odr = ILPS28QSW_10Hz;
-        break;
-      case ILPS28QSW_25Hz:
-        val->odr = ILPS28QSW_25Hz;
-        break;
-      case ILPS28QSW_50Hz:
-        val->odr = ILPS28QSW_50Hz;
-        break;
-      case ILPS28QSW_75Hz:
-        val->odr = ILPS28QSW_75Hz;
-        break;
-      case ILPS28QSW_100Hz:
-        val->odr = ILPS28QSW_100Hz;
-        break;
-      case ILPS28QSW_200Hz:
-        val->odr = ILPS28QSW_200Hz;
-        break;
-      default:
-        val->odr = ILPS28QSW_ONE_SHOT;
-        break;
-    }
+  bus_unlock(ctx);
 
-    switch (ctrl_reg1.avg)
-    {
-      case ILPS28QSW_4_AVG:
-        val->avg = ILPS28QSW_4_AVG;
-        break;
-      case ILPS28QSW_8_AVG:
-        val->avg = ILPS28QSW_8_AVG;
-        break;
-      case ILPS28QSW_16_AVG:
-        val->avg = ILPS28QSW_16_AVG;
-        break;
-      case ILPS28QSW_32_AVG:
-        val->avg = ILPS28QSW_32_AVG;
-        break;
-      case ILPS28QSW_64_AVG:
-        val->avg = ILPS28QSW_64_AVG;
-        break;
-      case ILPS28QSW_128_AVG:
-        val->avg = ILPS28QSW_128_AVG;
-        break;
-      case ILPS28QSW_256_AVG:
-        val->avg = ILPS28QSW_256_AVG;
-        break;
-      case ILPS28QSW_512_AVG:
-        val->avg = ILPS28QSW_512_AVG;
-        break;
-      default:
-        val->avg = ILPS28QSW_4_AVG;
-        break;
-    }
+  return ret;
+}
 
-    switch ((ctrl_reg2.lfpf_cfg << 2) | ctrl_reg2.en_lpfp)
-    {
-      case ILPS28QSW_LPF_DISABLE:
-        val->lpf = ILPS28QSW_LPF_DISABLE;
-        break;
-      case ILPS28QSW_LPF_ODR_DIV_4:
-        val->lpf = ILPS28QSW_LPF_ODR_DIV_4;
-        break;
-      case ILPS28QSW_LPF_ODR_DIV_9:
-        val->lpf = ILPS28QSW_LPF_ODR_DIV_9;
-        break;
-      default:
-        val->lpf = ILPS28QSW_LPF_DISABLE;
-        break;
-    }
+/**
+  * @brief  Record the FIFO level at trigger time, to be called on the
+  *         trigger interrupt. Optional, it splits the pre-trigger and
+  *         post-trigger windows in stream-to-FIFO mode.
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  cap   capture state.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_capture_mark(stmdev_ctx_t *ctx, ilps28qsw_capture_t *cap)
+{
+  uint8_t level;
+  int32_t ret;
 
-    val->interleaved_mode = ctrl_reg3.ah_qvar_p_auto_en;
+  bus_lock(ctx);
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_FIFO_STATUS1, &level, 1);
+  if ((ret == 0) && (cap->triggered == 0U))
+  {
+    if (cap->pre == ILPS28QSW_CAPTURE_PRE_UNKNOWN)
+    {
+      cap->pre = level;
+    }
+    cap->triggered = PROPERTY_ENABLE;
   }
+
+  bus_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  Software trigger for One-Shot.[get]
+  * @brief  Check with one burst of INT_SOURCE .. FIFO_STATUS2 if the
+  *         capture is complete: trigger seen (interrupt source, level
+  *         in bypass-first modes or ilps28qsw_capture_mark) and FIFO
+  *         full or at watermark. Reading INT_SOURCE clears a latched
+  *         interrupt.
   *
-  * @param  ctx   communication interface handler.(ptr)
-  * @param  md    the sensor conversion parameters.(ptr)
-  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  * @param  ctx     communication interface handler.(ptr)
+  * @param  cap     capture state.(ptr)
+  * @param  frozen  1 when the capture can be read.(ptr)
+  * @retval         interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t ilps28qsw_trigger_sw(stmdev_ctx_t *ctx, ilps28qsw_md_t *md)
+int32_t ilps28qsw_capture_poll(stmdev_ctx_t *ctx, ilps28qsw_capture_t *cap,
+                               uint8_t *frozen)
 {
-  ilps28qsw_ctrl_reg2_t ctrl_reg2;
-  int32_t ret = 0;
+  ilps28qsw_fifo_status2_t fifo_status2;
+  ilps28qsw_int_source_t int_source;
+  uint8_t reg[3];
+  int32_t ret;
 
-  if (md->odr == ILPS28QSW_ONE_SHOT)
+  *frozen = 0U;
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INT_SOURCE, reg, 3);
+
+  if (ret == 0)
   {
-    ret = ilps28qsw_read_reg(ctx, ILPS28QSW_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
-    ctrl_reg2.oneshot = PROPERTY_ENABLE;
-    if (ret == 0)
+    bytecpy((uint8_t *)&int_source, &reg[0]);
+    bytecpy((uint8_t *)&fifo_status2, &reg[2]);
+    cap->level = reg[1];
+
+    /* FIFO is empty before the trigger in bypass-first modes */
+    if ((int_source.ia == PROPERTY_ENABLE) ||
+        (((uint8_t)cap->fifo.operation !=
+          (uint8_t)ILPS28QSW_STREAM_TO_FIFO) && (cap->level > 0U)))
+    {
+      cap->triggered = PROPERTY_ENABLE;
+    }
+
+    if ((cap->triggered != 0U) &&
+        ((fifo_status2.fifo_full_ia == PROPERTY_ENABLE) ||
+         ((cap->fifo.watermark != 0U) &&
+          (fifo_status2.fifo_wtm_ia == PROPERTY_ENABLE))))
     {
-      ret = ilps28qsw_write_reg(ctx, ILPS28QSW_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
+      *frozen = 1U;
     }
   }
+
   return ret;
 }
 
 /**
-  * @brief  AH/QVAR function enable.[set]
+  * @brief  Drain a frozen capture, raw samples as ilps28qsw_fifo_raw_data_get,
+  *         and re-arm. The first cap->pre samples precede the trigger
+  *         (unless ILPS28QSW_CAPTURE_PRE_UNKNOWN).
   *
-  * @param  ctx    Read / write interface definitions
-  * @param  val    Change the value of ah_qvar_en in reg CTRL_REG3
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  cap   capture state, level from ilps28qsw_capture_poll.(ptr)
+  * @param  buff  caller buffer of 3 bytes per sample.(ptr)
+  * @param  len   buff size in bytes, samples exceeding it are discarded.
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t ilps28qsw_ah_qvar_en_set(stmdev_ctx_t *ctx, uint8_t val)
+int32_t ilps28qsw_capture_read(stmdev_ctx_t *ctx, ilps28qsw_capture_t *cap,
+                               uint8_t *buff, uint16_t len)
 {
-  ilps28qsw_ctrl_reg3_t ctrl_reg3;
+  uint8_t samp = cap->level;
+  uint8_t pre = cap->pre;
   int32_t ret;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_CTRL_REG3, (uint8_t *)&ctrl_reg3, 1);
+  if (((uint16_t)samp * ILPS28QSW_FIFO_SAMPLE_LEN) > len)
+  {
+    samp = (uint8_t)(len / ILPS28QSW_FIFO_SAMPLE_LEN);
+  }
 
+  bus_lock(ctx);
+  ret = ilps28qsw_fifo_raw_data_get(ctx, samp, buff);
   if (ret == 0)
   {
-    ctrl_reg3.ah_qvar_en = val;
-    ret = ilps28qsw_write_reg(ctx, ILPS28QSW_CTRL_REG3, (uint8_t *)&ctrl_reg3, 1);
+    ret = ilps28qsw_capture_arm(ctx, cap);
   }
 
+  /* keep the result of the capture read until the next poll */
+  cap->level = samp;
+  cap->pre = pre;
+
+  bus_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  AH/QVAR function enable.[get]
+  * @brief  Start AH_QVAR streaming: AH_QVAR enabled, FIFO in stream mode
+  *         with watermark. Set the ODR with ilps28qsw_mode_set, with
+  *         interleaved mode disabled, before.
   *
-  * @param  ctx    Read / write interface definitions
-  * @param  val    Return the value of ah_qvar_en in reg CTRL_REG3
-  * @retval        Interface status (MANDATORY: return 0 -> no Error).
+  * @param  ctx        communication interface handler.(ptr)
+  * @param  md         the sensor conversion parameters.(ptr)
+  * @param  watermark  FIFO watermark, samples.
+  * @retval            0 -> no Error, -1 -> interleaved mode enabled
   *
   */
-int32_t ilps28qsw_ah_qvar_en_get(stmdev_ctx_t *ctx, uint8_t *val)
+int32_t ilps28qsw_qvar_stream_start(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                                    uint8_t watermark)
 {
-  ilps28qsw_ctrl_reg3_t ctrl_reg3;
-  int32_t ret;
+  ilps28qsw_fifo_md_t fifo;
+  int32_t ret = -1;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_CTRL_REG3, (uint8_t *)&ctrl_reg3, 1);
-  *val = ctrl_reg3.ah_qvar_en;
+  bus_lock(ctx);
+  if (md->interleaved_mode == 0U)
+  {
+    fifo.operation = ILPS28QSW_BYPASS;
+    fifo.watermark = watermark;
+    ret = ilps28qsw_fifo_mode_set(ctx, &fifo);
+
+    if (ret == 0)
+    {
+      ret = ilps28qsw_ah_qvar_en_set(ctx, PROPERTY_ENABLE);
+    }
+    if (ret == 0)
+    {
+      fifo.operation = ILPS28QSW_STREAM;
+      ret = ilps28qsw_fifo_mode_set(ctx, &fifo);
+    }
+  }
+
+  bus_unlock(ctx);
 
   return ret;
 }
 
 /**
-  * @brief  Software trigger for One-Shot.[get]
+  * @brief  Initialize the AH_QVAR event detector, the baseline starts
+  *         from the first sample.
   *
-  * @param  ctx   communication interface handler.(ptr)
-  * @param  md    the sensor conversion parameters.(ptr)
-  * @param  data  data retrived from the sensor.(ptr)
-  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  * @param  det        AH_QVAR event detector.(ptr)
+  * @param  threshold  distance from baseline of an event, lsb.
+  * @param  shift      baseline EMA weight 1 / 2^shift (0 .. 15).
+  * @param  on_count   consecutive samples over threshold to start.
+  * @param  off_count  consecutive samples under threshold to end.
   *
   */
-int32_t ilps28qsw_data_get(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
-                           ilps28qsw_data_t *data)
+void ilps28qsw_qvar_det_init(ilps28qsw_qvar_det_t *det, int32_t threshold,
+                             uint8_t shift, uint8_t on_count,
+                             uint8_t off_count)
 {
-  uint8_t buff[5];
-  int32_t ret;
+  det->baseline = 0;
+  det->threshold = (threshold < 0) ? -threshold : threshold;
+  det->shift = (shift > 15U) ? 15U : shift;
+  det->on_count = (on_count == 0U) ? 1U : on_count;
+  det->off_count = (off_count == 0U) ? 1U : off_count;
+  det->cnt = 0U;
+  det->active = 0U;
+  det->init = 0U;
+}
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_PRESS_OUT_XL, buff, 5);
+/**
+  * @brief  Feed one AH_QVAR sample to the event detector.
+  *
+  * @param  det   AH_QVAR event detector.(ptr)
+  * @param  lsb   AH_QVAR sample, 24 bit right aligned.
+  * @retval       ILPS28QSW_QVAR_EV_NONE, _ON or _OFF
+  *
+  */
+uint8_t ilps28qsw_qvar_det_update(ilps28qsw_qvar_det_t *det, int32_t lsb)
+{
+  int64_t dist;
+  uint8_t over;
+  uint8_t ev = ILPS28QSW_QVAR_EV_NONE;
 
-  /* pressure conversion */
-  data->pressure.raw = (int32_t)buff[2];
-  data->pressure.raw = (data->pressure.raw * 256) + (int32_t) buff[1];
-  data->pressure.raw = (data->pressure.raw * 256) + (int32_t) buff[0];
-  data->pressure.raw = data->pressure.raw * 256;
+  if (det->init == 0U)
+  {
+    det->baseline = lsb * 256;
+    det->init = 1U;
+  }
 
-  if (md->interleaved_mode == 1U)
+  /* 64 bit: full scale swing against the opposite sign baseline */
+  dist = (int64_t)lsb - (int64_t)(det->baseline / 256);
+  dist = (dist < 0) ? -dist : dist;
+  over = (dist > det->threshold) ? 1U : 0U;
+
+  if (over != det->active)
   {
-    if ((buff[0] & 0x1U) == 0U)
-    {
-      /* data is a pressure sample */
-      switch (md->fs)
-      {
-        case ILPS28QSW_1260hPa:
-          data->pressure.hpa = ilps28qsw_from_fs1260_to_hPa(data->pressure.raw);
-          break;
-        case ILPS28QSW_4060hPa:
-          data->pressure.hpa = ilps28qsw_from_fs4000_to_hPa(data->pressure.raw);
-          break;
-        default:
-          data->pressure.hpa = 0.0f;
-          break;
-      }
-      data->ah_qvar.lsb = 0;
-    }
-    else
+    /* debounce the state change */
+    det->cnt++;
+    if (det->cnt >= ((det->active == 0U) ? det->on_count : det->off_count))
     {
-      /* data is a AH_QVAR sample */
-      data->ah_qvar.lsb = (data->pressure.raw / 256); /* shift 8bit left */
-      data->pressure.hpa = 0.0f;
+      det->active = over;
+      det->cnt = 0U;
+      ev = (over != 0U) ? ILPS28QSW_QVAR_EV_ON : ILPS28QSW_QVAR_EV_OFF;
     }
   }
   else
   {
-    switch (md->fs)
-    {
-      case ILPS28QSW_1260hPa:
-        data->pressure.hpa = ilps28qsw_from_fs1260_to_hPa(data->pressure.raw);
-        break;
-      case ILPS28QSW_4060hPa:
-        data->pressure.hpa = ilps28qsw_from_fs4000_to_hPa(data->pressure.raw);
-        break;
-      default:
-        data->pressure.hpa = 0.0f;
-        break;
-    }
-    data->ah_qvar.lsb = 0;
+    det->cnt = 0U;
   }
 
-  /* temperature conversion */
-  data->heat.raw = (int16_t)buff[4];
-  data->heat.raw = (data->heat.raw * 256) + (int16_t) buff[3];
-  data->heat.deg_c = ilps28qsw_from_lsb_to_celsius(data->heat.raw);
+  if ((det->active == 0U) && (over == 0U))
+  {
+    /* baseline follows the signal outside events only */
+    det->baseline += (int32_t)((((int64_t)lsb * 256) - det->baseline) /
+                               ((int64_t)1 << det->shift));
+  }
 
-  return ret;
+  return ev;
 }
 
 /**
-  * @brief  AH/QVAR data read.[get]
+  * @brief  Drain AH_QVAR samples from FIFO, in bursts of
+  *         ILPS28QSW_FIFO_DATA_CHUNK samples, through the event detector.
   *
   * @param  ctx   communication interface handler.(ptr)
-  * @param  md    the sensor conversion parameters.(ptr)
-  * @param  data  data retrived from the sensor.(ptr)
+  * @param  det   AH_QVAR event detector.(ptr)
+  * @param  val   samples read and events detected.(ptr)
   * @retval       interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t ilps28qsw_ah_qvar_data_get(stmdev_ctx_t *ctx,
-                                   ilps28qsw_ah_qvar_data_t *data)
+int32_t ilps28qsw_qvar_stream_service(stmdev_ctx_t *ctx,
+                                      ilps28qsw_qvar_det_t *det,
+                                      ilps28qsw_qvar_srv_t *val)
 {
-  uint8_t buff[5];
+  uint8_t buff[ILPS28QSW_FIFO_DATA_CHUNK * ILPS28QSW_FIFO_SAMPLE_LEN];
+  ilps28qsw_fifo_srv_t srv;
+  const uint8_t *b;
+  uint32_t u;
+  uint8_t chunk;
+  uint8_t ev;
+  uint8_t i = 0U;
+  uint8_t j;
   int32_t ret;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_PRESS_OUT_XL, buff, 3);
+  val->on = 0U;
+  val->off = 0U;
 
-  /* QVAR conversion */
-  data->raw = (int32_t)buff[2];
-  data->raw = (data->raw * 256) + (int32_t) buff[1];
-  data->raw = (data->raw * 256) + (int32_t) buff[0];
-  data->raw = (data->raw * 256);
-  data->lsb = (data->raw / 256); /* shift 8bit left */
+  ret = fifo_srv_status(ctx, &srv);
+  val->level = srv.level;
+  val->fifo_ovr = srv.fifo_ovr;
+
+  while ((ret == 0) && (i < srv.level))
+  {
+    chunk = srv.level - i;
+    chunk = (chunk > ILPS28QSW_FIFO_DATA_CHUNK) ?
+            (uint8_t)ILPS28QSW_FIFO_DATA_CHUNK : chunk;
+    ret = ilps28qsw_fifo_raw_data_get(ctx, chunk, buff);
+
+    for (j = 0U; (ret == 0) && (j < chunk); j++)
+    {
+      b = &buff[j * ILPS28QSW_FIFO_SAMPLE_LEN];
+      u = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16);
+      ev = ilps28qsw_qvar_det_update(det, (int32_t)(u << 8) / 256);
+      if (ev == ILPS28QSW_QVAR_EV_ON)
+      {
+        val->on++;
+      }
+      else if (ev == ILPS28QSW_QVAR_EV_OFF)
+      {
+        val->off++;
+      }
+      else
+      {
+        /* no event */
+      }
+    }
+    i += chunk;
+  }
+
+  val->active = det->active;
 
   return ret;
 }
@@ -765,199 +4044,319 @@ int32_t ilps28qsw_ah_qvar_data_get(stmdev_ctx_t *ctx,
   */
 
 /**
-  * @defgroup     FIFO functions
-  * @brief        This section groups all the functions concerning the
-  *               management of FIFO.
+  * @defgroup     Interrupt signals
+  * @brief        This section groups all the functions concerning
+  *               the management of interrupt signals.
   * @{
   *
   */
 
 /**
-  * @brief  FIFO operation mode selection.[set]
+  * @brief  Interrupt pins hardware signal configuration.[set]
   *
   * @param  ctx   communication interface handler.(ptr)
-  * @param  val   set the FIFO operation mode.(ptr)
+  * @param  val   the pins hardware signal settings.(ptr)
   * @retval       interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t ilps28qsw_fifo_mode_set(stmdev_ctx_t *ctx, ilps28qsw_fifo_md_t *val)
+int32_t ilps28qsw_interrupt_mode_set(stmdev_ctx_t *ctx,
+                                     ilps28qsw_int_mode_t *val)
 {
-  ilps28qsw_fifo_ctrl_t fifo_ctrl;
-  ilps28qsw_fifo_wtm_t fifo_wtm;
-  uint8_t reg[2];
+  ilps28qsw_interrupt_cfg_t interrupt_cfg;
   int32_t ret;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_FIFO_CTRL, reg, 2);
+  bus_lock(ctx);
+  ret = ilps28qsw_cfg_read(ctx, ILPS28QSW_INTERRUPT_CFG,
+                           (uint8_t *)&interrupt_cfg, 1);
   if (ret == 0)
   {
-    bytecpy((uint8_t *)&fifo_ctrl, &reg[0]);
-    bytecpy((uint8_t *)&fifo_wtm, &reg[1]);
+    interrupt_cfg.lir = val->int_latched ;
+    ret = ilps28qsw_cfg_write(ctx, ILPS28QSW_INTERRUPT_CFG,
+                              (uint8_t *)&interrupt_cfg, 1);
+  }
 
-    fifo_ctrl.f_mode = (uint8_t)val->operation & 0x03U;
-    fifo_ctrl.trig_modes = ((uint8_t)val->operation & 0x04U) >> 2;
+  bus_unlock(ctx);
 
-    if (val->watermark != 0x00U)
-    {
-      fifo_ctrl.stop_on_wtm = PROPERTY_ENABLE;
-    }
-    else
-    {
-      fifo_ctrl.stop_on_wtm = PROPERTY_DISABLE;
-    }
+  return ret;
+}
+
+/**
+  * @brief  Interrupt pins hardware signal configuration.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  val   the pins hardware signal settings.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_interrupt_mode_get(stmdev_ctx_t *ctx,
+                                     ilps28qsw_int_mode_t *val)
+{
+  ilps28qsw_interrupt_cfg_t interrupt_cfg;
+  int32_t ret;
+
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INTERRUPT_CFG,
+                           (uint8_t *)&interrupt_cfg, 1);
+
+  val->int_latched = interrupt_cfg.lir;
+
+  return ret;
+}
+
+/**
+  * @brief  AH function disable
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_ah_qvar_disable(stmdev_ctx_t *ctx)
+{
+  uint32_t val = 0;
+  int32_t ret;
+
+  ret = ilps28qsw_write_reg(ctx, ILPS28QSW_ANALOGIC_HUB_DISABLE, (uint8_t *)&val, 1);
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup     Interrupt on threshold functions
+  * @brief        This section groups all the functions concerning
+  *               the wake up functionality.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Configuration of Wake-up and Wake-up to Sleep .[set]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  val   parameters of configuration.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_int_on_threshold_mode_set(stmdev_ctx_t *ctx,
+                                            ilps28qsw_int_th_md_t *val)
+{
+  ilps28qsw_interrupt_cfg_t interrupt_cfg;
+  ilps28qsw_ths_p_l_t ths_p_l;
+  ilps28qsw_ths_p_h_t ths_p_h;
+  uint8_t reg[3];
+  int32_t ret;
 
-    fifo_wtm.wtm = val->watermark;
+  bus_lock(ctx);
+  ret = ilps28qsw_cfg_read(ctx, ILPS28QSW_INTERRUPT_CFG, reg, 3);
+  if (ret == 0)
+  {
+    bytecpy((uint8_t *)&interrupt_cfg, &reg[0]);
+    bytecpy((uint8_t *)&ths_p_l, &reg[1]);
+    bytecpy((uint8_t *)&ths_p_h, &reg[2]);
 
-    bytecpy(&reg[0], (uint8_t *)&fifo_ctrl);
-    bytecpy(&reg[1], (uint8_t *)&fifo_wtm);
+    interrupt_cfg.phe = val->over_th;
+    interrupt_cfg.ple = val->under_th;
+    ths_p_h.ths = (uint8_t)(val->threshold / 256U);
+    ths_p_l.ths = (uint8_t)(val->threshold - (ths_p_h.ths * 256U));
+
+    bytecpy(&reg[0], (uint8_t *)&interrupt_cfg);
+    bytecpy(&reg[1], (uint8_t *)&ths_p_l);
+    bytecpy(&reg[2], (uint8_t *)&ths_p_h);
 
-    ret = ilps28qsw_write_reg(ctx, ILPS28QSW_FIFO_CTRL, reg, 2);
+    ret = ilps28qsw_cfg_write(ctx, ILPS28QSW_INTERRUPT_CFG, reg, 3);
   }
+
+  bus_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  FIFO operation mode selection.[get]
+  * @brief  Configuration of Wake-up and Wake-up to Sleep .[set]
   *
   * @param  ctx   communication interface handler.(ptr)
-  * @param  val   get the FIFO operation mode.(ptr)
+  * @param  val   parameters of configuration.(ptr)
   * @retval       interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t ilps28qsw_fifo_mode_get(stmdev_ctx_t *ctx, ilps28qsw_fifo_md_t *val)
+int32_t ilps28qsw_int_on_threshold_mode_get(stmdev_ctx_t *ctx,
+                                            ilps28qsw_int_th_md_t *val)
 {
-  ilps28qsw_fifo_ctrl_t fifo_ctrl;
-  ilps28qsw_fifo_wtm_t fifo_wtm;
-  uint8_t reg[2];
+  ilps28qsw_interrupt_cfg_t interrupt_cfg;
+  ilps28qsw_ths_p_l_t ths_p_l;
+  ilps28qsw_ths_p_h_t ths_p_h;
+  uint8_t reg[3];
   int32_t ret;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_FIFO_CTRL, reg, 2);
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INTERRUPT_CFG, reg, 3);
 
-  bytecpy((uint8_t *)&fifo_ctrl, &reg[0]);
-  bytecpy((uint8_t *)&fifo_wtm, &reg[1]);
+  bytecpy((uint8_t *)&interrupt_cfg, &reg[0]);
+  bytecpy((uint8_t *)&ths_p_l, &reg[1]);
+  bytecpy((uint8_t *)&ths_p_h, &reg[2]);
 
-  switch ((fifo_ctrl.trig_modes << 2) | fifo_ctrl.f_mode)
+  val->over_th = interrupt_cfg.phe;
+  val->under_th = interrupt_cfg.ple;
+  val->threshold = ths_p_h.ths;
+  val->threshold = (val->threshold * 256U)  + ths_p_l.ths;
+
+  return ret;
+}
+
+/*
+ * Arm the threshold interrupt around the current pressure: AUTOREFP takes
+ * the reference on its enable, written in the same burst as thresholds and
+ * events. When AUTOREFP is already enabled (re-arm) the old reference must
+ * be dropped first with a separate RESET_ARP write: the datasheet does not
+ * define RESET_ARP and AUTOREFP set in the same write, and the reference
+ * would not be taken again without a disabled to enabled transition.
+ */
+static int32_t th_engine_arm(stmdev_ctx_t *ctx, ilps28qsw_th_engine_t *eng)
+{
+  ilps28qsw_interrupt_cfg_t interrupt_cfg;
+  ilps28qsw_ths_p_l_t ths_p_l;
+  ilps28qsw_ths_p_h_t ths_p_h;
+  float_t ths;
+  uint16_t th;
+  uint8_t reg[3];
+  int32_t ret;
+
+  /* threshold in hPa * 16 (@1260hPa), hPa * 8 (@4060hPa) */
+  ths = (eng->md.fs == ILPS28QSW_4060hPa) ? (eng->delta_hpa * 8.0f) :
+        (eng->delta_hpa * 16.0f);
+  th = (ths >= 32767.0f) ? 0x7FFFU : ((ths > 0.0f) ? (uint16_t)ths : 0U);
+
+  ret = ilps28qsw_cfg_read(ctx, ILPS28QSW_INTERRUPT_CFG, reg, 3);
+  bytecpy((uint8_t *)&interrupt_cfg, &reg[0]);
+  if ((ret == 0) && (interrupt_cfg.autorefp == PROPERTY_ENABLE))
   {
-    case ILPS28QSW_BYPASS:
-      val->operation = ILPS28QSW_BYPASS;
-      break;
-    case ILPS28QSW_FIFO:
-      val->operation = ILPS28QSW_FIFO;
-      break;
-    case ILPS28QSW_STREAM:
-      val->operation = ILPS28QSW_STREAM;
-      break;
-    case ILPS28QSW_STREAM_TO_FIFO:
-      val->operation = ILPS28QSW_STREAM_TO_FIFO;
-      break;
-    case ILPS28QSW_BYPASS_TO_STREAM:
-      val->operation = ILPS28QSW_BYPASS_TO_STREAM;
-      break;
-    case ILPS28QSW_BYPASS_TO_FIFO:
-      val->operation = ILPS28QSW_BYPASS_TO_FIFO;
-      break;
-    default:
-      val->operation = ILPS28QSW_BYPASS;
-      break;
+    interrupt_cfg.autorefp = PROPERTY_DISABLE;
+    interrupt_cfg.reset_arp = PROPERTY_ENABLE;
+    ret = ilps28qsw_cfg_write(ctx, ILPS28QSW_INTERRUPT_CFG,
+                              (uint8_t *)&interrupt_cfg, 1);
   }
 
-  val->watermark = fifo_wtm.wtm;
+  if (ret == 0)
+  {
+    interrupt_cfg.reset_arp = PROPERTY_DISABLE;
+    interrupt_cfg.reset_az = PROPERTY_DISABLE;
+    interrupt_cfg.autozero = PROPERTY_DISABLE;
+    interrupt_cfg.autorefp = PROPERTY_ENABLE;
+    interrupt_cfg.phe = PROPERTY_ENABLE;
+    interrupt_cfg.ple = PROPERTY_ENABLE;
+    bytecpy((uint8_t *)&ths_p_l, &reg[1]);
+    bytecpy((uint8_t *)&ths_p_h, &reg[2]);
+    ths_p_h.ths = (uint8_t)(th / 256U);
+    ths_p_l.ths = (uint8_t)(th - (ths_p_h.ths * 256U));
+
+    bytecpy(&reg[0], (uint8_t *)&interrupt_cfg);
+    bytecpy(&reg[1], (uint8_t *)&ths_p_l);
+    bytecpy(&reg[2], (uint8_t *)&ths_p_h);
+    ret = ilps28qsw_cfg_write(ctx, ILPS28QSW_INTERRUPT_CFG, reg, 3);
+  }
 
   return ret;
 }
 
 /**
-  * @brief  Get the number of samples stored in FIFO.[get]
+  * @brief  Start the delta wake-up engine: the threshold interrupt is
+  *         armed around the current pressure, the device must be in
+  *         continuous mode.
   *
   * @param  ctx   communication interface handler.(ptr)
-  * @param  md    the sensor conversion parameters.(ptr)
-  * @param  val   number of samples stored in FIFO.(ptr)
+  * @param  eng   threshold engine, md, delta_hpa, hyst_hpa, cb and arg
+  *               set by the caller.(ptr)
   * @retval       interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t ilps28qsw_fifo_level_get(stmdev_ctx_t *ctx, uint8_t *val)
+int32_t ilps28qsw_th_engine_start(stmdev_ctx_t *ctx,
+                                  ilps28qsw_th_engine_t *eng)
 {
-  ilps28qsw_fifo_status1_t fifo_status1;
+  ilps28qsw_data_t data;
   int32_t ret;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_FIFO_STATUS1,
-                           (uint8_t *)&fifo_status1, 1);
+  bus_lock(ctx);
+  ret = ilps28qsw_data_get(ctx, &eng->md, &data);
+  if (ret == 0)
+  {
+    eng->ref_hpa = data.pressure.hpa;
+    eng->last_dir = 0;
+    ret = th_engine_arm(ctx, eng);
+  }
 
-  *val = fifo_status1.fss;
+  bus_unlock(ctx);
 
   return ret;
 }
 
 /**
-  * @brief  Software trigger for One-Shot.[get]
+  * @brief  Handle a threshold interrupt: read the sources and pressure
+  *         with one snapshot, call back on a change of at least delta
+  *         from the last event (delta + hysteresis on direction reversal)
+  *         and re-arm around the new pressure. Task context only (e.g.
+  *         deferred from the INT pin ISR), as it takes the bus lock.
   *
   * @param  ctx   communication interface handler.(ptr)
-  * @param  md    the sensor conversion parameters.(ptr)
-  * @param  fmd   get the FIFO operation mode.(ptr)
-  * @param  samp  number of samples stored in FIFO.(ptr)
-  * @param  data  data retrived from FIFO.(ptr)
+  * @param  eng   threshold engine.(ptr)
   * @retval       interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t ilps28qsw_fifo_data_get(stmdev_ctx_t *ctx, uint8_t samp,
-                                ilps28qsw_md_t *md, ilps28qsw_fifo_data_t *data)
+int32_t ilps28qsw_th_engine_event(stmdev_ctx_t *ctx,
+                                  ilps28qsw_th_engine_t *eng)
 {
-  uint8_t fifo_data[3];
-  uint8_t i;
-  int32_t ret = 0;
+  ilps28qsw_poll_snapshot_t snap;
+  float_t change;
+  float_t limit;
+  int8_t dir = 0;
+  int32_t ret;
 
-  for (i = 0U; i < samp; i++)
-  {
-    ret = ilps28qsw_read_reg(ctx, ILPS28QSW_FIFO_DATA_OUT_PRESS_XL, fifo_data, 3);
-    data[i].raw = (int32_t)fifo_data[2];
-    data[i].raw = (data[i].raw * 256) + (int32_t)fifo_data[1];
-    data[i].raw = (data[i].raw * 256) + (int32_t)fifo_data[0];
-    data[i].raw = (data[i].raw * 256);
+  bus_lock(ctx);
+  ret = ilps28qsw_poll_snapshot_get(ctx, &eng->md, &snap);
 
-    if (md->interleaved_mode == 1U)
+  if (ret == 0)
+  {
+    if (snap.sources.over_pres == PROPERTY_ENABLE)
     {
-      if ((fifo_data[0] & 0x1U) == 0U)
-      {
-        /* data is a pressure sample */
-        switch (md->fs)
-        {
-          case ILPS28QSW_1260hPa:
-            data[i].hpa = ilps28qsw_from_fs1260_to_hPa(data[i].raw);
-            break;
-          case ILPS28QSW_4060hPa:
-            data[i].hpa = ilps28qsw_from_fs4000_to_hPa(data[i].raw);
-            break;
-          default:
-            data[i].hpa = 0.0f;
-            break;
-        }
-        data[i].lsb = 0;
-      }
-      else
-      {
-        /* data is a AH_QVAR sample */
-        data[i].lsb = (data[i].raw / 256); /* shift 8bit left */
-        data[i].hpa = 0.0f;
-      }
+      dir = 1;
+    }
+    else if (snap.sources.under_pres == PROPERTY_ENABLE)
+    {
+      dir = -1;
     }
     else
     {
-      switch (md->fs)
+      /* not a threshold event */
+    }
+  }
+
+  if (dir != 0)
+  {
+    change = snap.data.pressure.hpa - eng->ref_hpa;
+    change = (change < 0.0f) ? -change : change;
+    limit = eng->delta_hpa;
+    if ((eng->last_dir != 0) && (dir != eng->last_dir))
+    {
+      limit += eng->hyst_hpa;
+    }
+
+    /* changes below the limit re-arm only, the host reference is kept */
+    if (change >= limit)
+    {
+      eng->ref_hpa = snap.data.pressure.hpa;
+      eng->last_dir = dir;
+      if (eng->cb != NULL)
       {
-        case ILPS28QSW_1260hPa:
-          data[i].hpa = ilps28qsw_from_fs1260_to_hPa(data[i].raw);
-          break;
-        case ILPS28QSW_4060hPa:
-          data[i].hpa = ilps28qsw_from_fs4000_to_hPa(data[i].raw);
-          break;
-        default:
-          data[i].hpa = 0.0f;
-          break;
+        eng->cb(ctx, dir, &snap, eng->arg);
       }
-      data[i].lsb = 0;
     }
 
+    ret = th_engine_arm(ctx, eng);
   }
 
+  bus_unlock(ctx);
+
   return ret;
 }
 
@@ -967,48 +4366,56 @@ int32_t ilps28qsw_fifo_data_get(stmdev_ctx_t *ctx, uint8_t samp,
   */
 
 /**
-  * @defgroup     Interrupt signals
+  * @defgroup     Reference value of pressure
   * @brief        This section groups all the functions concerning
-  *               the management of interrupt signals.
+  *               the wake up functionality.
   * @{
   *
   */
 
 /**
-  * @brief  Interrupt pins hardware signal configuration.[set]
+  * @brief  Configuration of Wake-up and Wake-up to Sleep .[set]
   *
   * @param  ctx   communication interface handler.(ptr)
-  * @param  val   the pins hardware signal settings.(ptr)
+  * @param  val   parameters of configuration.(ptr)
   * @retval       interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t ilps28qsw_interrupt_mode_set(stmdev_ctx_t *ctx,
-                                     ilps28qsw_int_mode_t *val)
+int32_t ilps28qsw_reference_mode_set(stmdev_ctx_t *ctx, ilps28qsw_ref_md_t *val)
 {
   ilps28qsw_interrupt_cfg_t interrupt_cfg;
   int32_t ret;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INTERRUPT_CFG,
+  bus_lock(ctx);
+  ret = ilps28qsw_cfg_read(ctx, ILPS28QSW_INTERRUPT_CFG,
                            (uint8_t *)&interrupt_cfg, 1);
   if (ret == 0)
   {
-    interrupt_cfg.lir = val->int_latched ;
-    ret = ilps28qsw_write_reg(ctx, ILPS28QSW_INTERRUPT_CFG,
+
+    interrupt_cfg.autozero = val->get_ref;
+    interrupt_cfg.autorefp = (uint8_t)val->apply_ref & 0x01U;
+
+    interrupt_cfg.reset_az  = ((uint8_t)val->apply_ref & 0x02U) >> 1;
+    interrupt_cfg.reset_arp = ((uint8_t)val->apply_ref & 0x02U) >> 1;
+
+    ret = ilps28qsw_cfg_write(ctx, ILPS28QSW_INTERRUPT_CFG,
                               (uint8_t *)&interrupt_cfg, 1);
   }
+
+  bus_unlock(ctx);
+
   return ret;
 }
 
 /**
-  * @brief  Interrupt pins hardware signal configuration.[get]
+  * @brief  Configuration of Wake-up and Wake-up to Sleep .[set]
   *
   * @param  ctx   communication interface handler.(ptr)
-  * @param  val   the pins hardware signal settings.(ptr)
+  * @param  val   parameters of configuration.(ptr)
   * @retval       interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t ilps28qsw_interrupt_mode_get(stmdev_ctx_t *ctx,
-                                     ilps28qsw_int_mode_t *val)
+int32_t ilps28qsw_reference_mode_get(stmdev_ctx_t *ctx, ilps28qsw_ref_md_t *val)
 {
   ilps28qsw_interrupt_cfg_t interrupt_cfg;
   int32_t ret;
@@ -1016,106 +4423,243 @@ int32_t ilps28qsw_interrupt_mode_get(stmdev_ctx_t *ctx,
   ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INTERRUPT_CFG,
                            (uint8_t *)&interrupt_cfg, 1);
 
-  val->int_latched = interrupt_cfg.lir;
+  switch ((interrupt_cfg.reset_az << 1) |
+          interrupt_cfg.autorefp)
+  {
+    case ILPS28QSW_OUT_AND_INTERRUPT:
+      val->apply_ref = ILPS28QSW_OUT_AND_INTERRUPT;
+      break;
+    case ILPS28QSW_ONLY_INTERRUPT:
+      val->apply_ref = ILPS28QSW_ONLY_INTERRUPT;
+      break;
+    default:
+      val->apply_ref = ILPS28QSW_RST_REFS;
+      break;
+  }
+  val->get_ref = interrupt_cfg.autozero;
 
   return ret;
 }
 
+
 /**
-  * @brief  AH function disable
+  * @brief  Configuration of Wake-up and Wake-up to Sleep .[set]
   *
   * @param  ctx   communication interface handler.(ptr)
+  * @param  val   parameters of configuration.(ptr)
   * @retval       interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t ilps28qsw_ah_qvar_disable(stmdev_ctx_t *ctx)
+int32_t ilps28qsw_opc_set(stmdev_ctx_t *ctx, int16_t val)
 {
-  uint32_t val = 0;
+  uint8_t reg[2];
   int32_t ret;
 
-  ret = ilps28qsw_write_reg(ctx, ILPS28QSW_ANALOGIC_HUB_DISABLE, (uint8_t *)&val, 1);
+  reg[1] = (uint8_t)(((uint16_t)val & 0xFF00U) / 256U);
+  reg[0] = (uint8_t)((uint16_t)val & 0x00FFU);
+
+  ret = ilps28qsw_write_reg(ctx, ILPS28QSW_RPDS_L, reg, 2);
+
+  return ret;
+}
+
+/**
+  * @brief  Configuration of Wake-up and Wake-up to Sleep .[set]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  val   parameters of configuration.(ptr)
+  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t ilps28qsw_opc_get(stmdev_ctx_t *ctx, int16_t *val)
+{
+  uint8_t reg[2];
+  int32_t ret;
+
+  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_RPDS_L, reg, 2);
+
+  *val = (int16_t)reg[1];
+  *val = *val * 256 + (int16_t)reg[0];
 
   return ret;
 }
 
+
 /**
   * @}
   *
   */
 
 /**
-  * @defgroup     Interrupt on threshold functions
-  * @brief        This section groups all the functions concerning
-  *               the wake up functionality.
+  * @defgroup     Configuration plan
+  * @brief        This section groups the functions to apply a complete
+  *               device profile with the minimum number of transactions.
   * @{
   *
   */
 
+/*
+ * Append a register image to the plan.
+ */
+static void plan_add(ilps28qsw_plan_t *plan, uint8_t reg, uint8_t *data)
+{
+  plan->line[plan->len].address = reg;
+  bytecpy(&plan->line[plan->len].data, data);
+  plan->len++;
+}
+
 /**
-  * @brief  Configuration of Wake-up and Wake-up to Sleep .[set]
+  * @brief  Compile a device profile into an ordered register write plan.
+  *         The device is powered down with AH_QVAR disabled before the
+  *         interleaved mode, interrupt, FIFO and interface settings are
+  *         written; ODR and AH_QVAR are enabled last. Registers are
+  *         ordered by address to be coalesced in 5 burst writes at most.
+  *         The plan can be inspected and kept for replay.
   *
-  * @param  ctx   communication interface handler.(ptr)
-  * @param  val   parameters of configuration.(ptr)
-  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  * @param  prof  device profile.(ptr)
+  * @param  plan  register write plan.(ptr)
   *
   */
-int32_t ilps28qsw_int_on_threshold_mode_set(stmdev_ctx_t *ctx,
-                                            ilps28qsw_int_th_md_t *val)
+void ilps28qsw_plan_build(const ilps28qsw_profile_t *prof,
+                          ilps28qsw_plan_t *plan)
 {
   ilps28qsw_interrupt_cfg_t interrupt_cfg;
+  ilps28qsw_i3c_if_ctrl_t i3c_if_ctrl;
+  ilps28qsw_ctrl_reg1_t ctrl_reg1;
+  ilps28qsw_ctrl_reg2_t ctrl_reg2;
+  ilps28qsw_ctrl_reg3_t ctrl_reg3;
+  ilps28qsw_fifo_ctrl_t fifo_ctrl;
+  ilps28qsw_fifo_wtm_t fifo_wtm;
   ilps28qsw_ths_p_l_t ths_p_l;
   ilps28qsw_ths_p_h_t ths_p_h;
-  uint8_t reg[3];
-  int32_t ret;
-
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INTERRUPT_CFG, reg, 3);
-  if (ret == 0)
+  ilps28qsw_if_ctrl_t if_ctrl;
+  uint8_t zero = 0U;
+
+  bytecpy((uint8_t *)&interrupt_cfg, &zero);
+  bytecpy((uint8_t *)&i3c_if_ctrl, &zero);
+  bytecpy((uint8_t *)&ctrl_reg1, &zero);
+  bytecpy((uint8_t *)&ctrl_reg2, &zero);
+  bytecpy((uint8_t *)&ctrl_reg3, &zero);
+  bytecpy((uint8_t *)&fifo_ctrl, &zero);
+  bytecpy((uint8_t *)&fifo_wtm, &zero);
+  bytecpy((uint8_t *)&ths_p_l, &zero);
+  bytecpy((uint8_t *)&ths_p_h, &zero);
+  bytecpy((uint8_t *)&if_ctrl, &zero);
+
+  plan->len = 0U;
+
+  /* power-down, conversion and interface settings, AH_QVAR disabled */
+  ctrl_reg2.bdu = PROPERTY_ENABLE;
+  ctrl_reg2.en_lpfp = (uint8_t)prof->md.lpf & 0x01U;
+  ctrl_reg2.lfpf_cfg = ((uint8_t)prof->md.lpf & 0x02U) >> 1;
+  ctrl_reg2.fs_mode = (uint8_t)prof->md.fs;
+  ctrl_reg3.if_add_inc = PROPERTY_ENABLE;
+  ctrl_reg3.ah_qvar_p_auto_en = prof->md.interleaved_mode;
+  plan_add(plan, ILPS28QSW_CTRL_REG1, (uint8_t *)&ctrl_reg1);
+  plan_add(plan, ILPS28QSW_CTRL_REG2, (uint8_t *)&ctrl_reg2);
+  plan_add(plan, ILPS28QSW_CTRL_REG3, (uint8_t *)&ctrl_reg3);
+
+  /* interrupt, threshold, reference and pins */
+  interrupt_cfg.phe = prof->int_th.over_th;
+  interrupt_cfg.ple = prof->int_th.under_th;
+  interrupt_cfg.lir = prof->int_mode.int_latched;
+  interrupt_cfg.autozero = prof->ref.get_ref;
+  interrupt_cfg.autorefp = (uint8_t)prof->ref.apply_ref & 0x01U;
+  interrupt_cfg.reset_az  = ((uint8_t)prof->ref.apply_ref & 0x02U) >> 1;
+  interrupt_cfg.reset_arp = ((uint8_t)prof->ref.apply_ref & 0x02U) >> 1;
+  ths_p_h.ths = (uint8_t)(prof->int_th.threshold / 256U);
+  ths_p_l.ths = (uint8_t)(prof->int_th.threshold - (ths_p_h.ths * 256U));
+  if_ctrl.sda_pu_en = prof->pin.sda_pull_up;
+  plan_add(plan, ILPS28QSW_INTERRUPT_CFG, (uint8_t *)&interrupt_cfg);
+  plan_add(plan, ILPS28QSW_THS_P_L, (uint8_t *)&ths_p_l);
+  plan_add(plan, ILPS28QSW_THS_P_H, (uint8_t *)&ths_p_h);
+  plan_add(plan, ILPS28QSW_IF_CTRL, (uint8_t *)&if_ctrl);
+
+  /* FIFO */
+  fifo_ctrl.f_mode = (uint8_t)prof->fifo.operation & 0x03U;
+  fifo_ctrl.trig_modes = ((uint8_t)prof->fifo.operation & 0x04U) >> 2;
+  fifo_ctrl.stop_on_wtm = (prof->fifo.watermark != 0x00U) ?
+                          PROPERTY_ENABLE : PROPERTY_DISABLE;
+  fifo_ctrl.ah_qvar_p_fifo_en = prof->md.interleaved_mode;
+  fifo_wtm.wtm = prof->fifo.watermark;
+  plan_add(plan, ILPS28QSW_FIFO_CTRL, (uint8_t *)&fifo_ctrl);
+  plan_add(plan, ILPS28QSW_FIFO_WTM, (uint8_t *)&fifo_wtm);
+
+  /* bus */
+  i3c_if_ctrl.asf_on = (uint8_t)prof->bus.filter & 0x01U;
+  plan_add(plan, ILPS28QSW_I3C_IF_CTRL, (uint8_t *)&i3c_if_ctrl);
+
+  /* ODR and AH_QVAR enabled last */
+  ctrl_reg1.odr = (uint8_t)prof->md.odr;
+  ctrl_reg1.avg = (uint8_t)prof->md.avg;
+  plan_add(plan, ILPS28QSW_CTRL_REG1, (uint8_t *)&ctrl_reg1);
+  if (prof->ah_qvar_en != 0U)
   {
-    bytecpy((uint8_t *)&interrupt_cfg, &reg[0]);
-    bytecpy((uint8_t *)&ths_p_l, &reg[1]);
-    bytecpy((uint8_t *)&ths_p_h, &reg[2]);
-
-    interrupt_cfg.phe = val->over_th;
-    interrupt_cfg.ple = val->under_th;
-    ths_p_h.ths = (uint8_t)(val->threshold / 256U);
-    ths_p_l.ths = (uint8_t)(val->threshold - (ths_p_h.ths * 256U));
-
-    bytecpy(&reg[0], (uint8_t *)&interrupt_cfg);
-    bytecpy(&reg[1], (uint8_t *)&ths_p_l);
-    bytecpy(&reg[2], (uint8_t *)&ths_p_h);
-
-    ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INTERRUPT_CFG, reg, 3);
+    ctrl_reg3.ah_qvar_en = PROPERTY_ENABLE;
+    plan_add(plan, ILPS28QSW_CTRL_REG2, (uint8_t *)&ctrl_reg2);
+    plan_add(plan, ILPS28QSW_CTRL_REG3, (uint8_t *)&ctrl_reg3);
   }
-  return ret;
 }
 
 /**
-  * @brief  Configuration of Wake-up and Wake-up to Sleep .[set]
+  * @brief  Apply a register write plan, e.g. compiled at start-up and
+  *         replayed for fast re-initialization after brown-out.
   *
   * @param  ctx   communication interface handler.(ptr)
-  * @param  val   parameters of configuration.(ptr)
+  * @param  plan  register write plan.(ptr)
   * @retval       interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t ilps28qsw_int_on_threshold_mode_get(stmdev_ctx_t *ctx,
-                                            ilps28qsw_int_th_md_t *val)
+int32_t ilps28qsw_plan_apply(stmdev_ctx_t *ctx, const ilps28qsw_plan_t *plan)
 {
-  ilps28qsw_interrupt_cfg_t interrupt_cfg;
-  ilps28qsw_ths_p_l_t ths_p_l;
-  ilps28qsw_ths_p_h_t ths_p_h;
-  uint8_t reg[3];
-  int32_t ret;
+  ilps28qsw_priv_t *priv = priv_get(ctx);
+  ilps28qsw_xfer_t xfer[ILPS28QSW_PLAN_MAX];
+  uint8_t data[ILPS28QSW_PLAN_MAX];
+  ilps28qsw_ctrl_reg3_t ctrl_reg3;
+  uint8_t n = 0U;
+  uint8_t i;
+  int32_t ret = 0;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INTERRUPT_CFG, reg, 3);
+  bus_lock(ctx);
+  if ((priv != NULL) && (priv->xfer != NULL))
+  {
+    ret = ilps28qsw_cfg_read(ctx, ILPS28QSW_CTRL_REG3,
+                             (uint8_t *)&ctrl_reg3, 1);
+  }
 
-  bytecpy((uint8_t *)&interrupt_cfg, &reg[0]);
-  bytecpy((uint8_t *)&ths_p_l, &reg[1]);
-  bytecpy((uint8_t *)&ths_p_h, &reg[2]);
+  if ((ret == 0) && (priv != NULL) && (priv->xfer != NULL) &&
+      (ctrl_reg3.if_add_inc == PROPERTY_ENABLE))
+  {
+    /* plan bursts in a single batched transfer */
+    for (i = 0U; i < plan->len; i++)
+    {
+      data[i] = plan->line[i].data;
+      if ((n > 0U) && (plan->line[i].address ==
+                       (uint8_t)(xfer[n - 1U].reg + xfer[n - 1U].len)))
+      {
+        xfer[n - 1U].len++;
+      }
+      else
+      {
+        xfer[n].reg = plan->line[i].address;
+        xfer[n].rd = 0U;
+        xfer[n].len = 1U;
+        xfer[n].data = &data[i];
+        n++;
+      }
+    }
+    ret = xfer_run(ctx, xfer, n);
+  }
+  else if (ret == 0)
+  {
+    ret = ilps28qsw_ucf_load(ctx, plan->line, plan->len, PROPERTY_DISABLE);
+  }
+  else
+  {
+    /* interface error */
+  }
 
-  val->over_th = interrupt_cfg.phe;
-  val->under_th = interrupt_cfg.ple;
-  val->threshold = ths_p_h.ths;
-  val->threshold = (val->threshold * 256U)  + ths_p_l.ths;
+  bus_unlock(ctx);
 
   return ret;
 }
@@ -1126,120 +4670,452 @@ int32_t ilps28qsw_int_on_threshold_mode_get(stmdev_ctx_t *ctx,
   */
 
 /**
-  * @defgroup     Reference value of pressure
-  * @brief        This section groups all the functions concerning
-  *               the wake up functionality.
+  * @defgroup     Estimator
+  * @brief        This section groups the functions to compare candidate
+  *               configurations before applying them.
   * @{
   *
   */
 
 /**
-  * @brief  Configuration of Wake-up and Wake-up to Sleep .[set]
+  * @brief  Estimate supply current, noise, bus usage, host wake-ups and
+  *         latency of a configuration.
   *
-  * @param  ctx   communication interface handler.(ptr)
-  * @param  val   parameters of configuration.(ptr)
-  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  * @param  md      the sensor conversion parameters.(ptr)
+  * @param  fifo    FIFO mode and watermark, watermark 0 as FIFO full.(ptr)
+  * @param  bus_hz  bus clock in Hz.
+  * @param  burst   FIFO samples per read burst, 0 ILPS28QSW_FIFO_BURST_MAX.
+  * @param  val     estimated figures.(ptr)
+  * @retval         0 -> no Error, -1 -> one-shot mode, null bus clock or
+  *                 conversion time longer than FIFO entry period
   *
   */
-int32_t ilps28qsw_reference_mode_set(stmdev_ctx_t *ctx, ilps28qsw_ref_md_t *val)
+int32_t ilps28qsw_estimate(ilps28qsw_md_t *md, ilps28qsw_fifo_md_t *fifo,
+                           uint32_t bus_hz, uint16_t burst,
+                           ilps28qsw_est_t *val)
 {
-  ilps28qsw_interrupt_cfg_t interrupt_cfg;
-  int32_t ret;
+  /* 1 / sqrt(2^avg) */
+  static const float_t avg_gain[8] =
+  {
+    1.0f, 0.7071068f, 0.5f, 0.3535534f, 0.25f, 0.1767767f, 0.125f,
+    0.0883883f,
+  };
+  uint32_t period = fifo_entry_period_q8(md) >> 8;
+  float_t entry_hz;
+  float_t bits;
+  uint32_t conv;
+  uint32_t wtm;
+  uint32_t tx;
+  int32_t ret = 0;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INTERRUPT_CFG,
-                           (uint8_t *)&interrupt_cfg, 1);
-  if (ret == 0)
+  if ((period == 0U) || (bus_hz == 0U) ||
+      (ilps28qsw_conv_time_us(md) > period))
+  {
+    ret = -1;
+  }
+  else
   {
+    conv = ilps28qsw_conv_time_us(md);
+    entry_hz = 256000000.0f / (float_t)fifo_entry_period_q8(md);
+    burst = ((burst == 0U) || (burst > 128U)) ? ILPS28QSW_FIFO_BURST_MAX : burst;
 
-    interrupt_cfg.autozero = val->get_ref;
-    interrupt_cfg.autorefp = (uint8_t)val->apply_ref & 0x01U;
+    val->idd_ua = ILPS28QSW_EST_IDD_PD_UA +
+                  (ILPS28QSW_EST_IDD_ACT_UA * entry_hz * (float_t)conv /
+                   1000000.0f);
 
-    interrupt_cfg.reset_az  = ((uint8_t)val->apply_ref & 0x02U) >> 1;
-    interrupt_cfg.reset_arp = ((uint8_t)val->apply_ref & 0x02U) >> 1;
+    val->noise_pa = ILPS28QSW_EST_NOISE_PA *
+                    avg_gain[(uint8_t)md->avg & 0x07U];
+    if (md->lpf == ILPS28QSW_LPF_ODR_DIV_4)
+    {
+      /* bandwidth ODR / 4 over ODR / 2 */
+      val->noise_pa *= 0.7071f;
+    }
+    else if (md->lpf == ILPS28QSW_LPF_ODR_DIV_9)
+    {
+      /* bandwidth ODR / 9 over ODR / 2 */
+      val->noise_pa *= 0.4714f;
+    }
+    else
+    {
+      /* LPF disabled */
+    }
+    if (md->fs == ILPS28QSW_4060hPa)
+    {
+      val->noise_pa *= ILPS28QSW_EST_NOISE_4060_GAIN;
+    }
+
+    /* interleaved mode: one FIFO entry in two is AH_QVAR */
+    val->press_hz = (md->interleaved_mode == 1U) ? (entry_hz / 2.0f) :
+                    entry_hz;
 
-    ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INTERRUPT_CFG,
-                             (uint8_t *)&interrupt_cfg, 1);
+    if (fifo->operation == ILPS28QSW_BYPASS)
+    {
+      /* ilps28qsw_data_get() on each data-ready */
+      wtm = 1U;
+      tx = 1U;
+      bits = (float_t)ILPS28QSW_EST_TX_BITS + (9.0f * 5.0f);
+    }
+    else
+    {
+      /* FIFO_STATUS1 .. 2 and the FIFO bursts of a watermark */
+      wtm = (fifo->watermark == 0U) ? 128U : fifo->watermark;
+      tx = 1U + ((wtm + burst - 1U) / burst);
+      bits = ((float_t)tx * (float_t)ILPS28QSW_EST_TX_BITS) +
+             (9.0f * (2.0f + ((float_t)wtm * ILPS28QSW_FIFO_SAMPLE_LEN)));
+    }
+
+    val->wakeup_hz = entry_hz / (float_t)wtm;
+    val->tx_hz = val->wakeup_hz * (float_t)tx;
+    val->bus_bps = val->wakeup_hz * bits;
+    val->bus_load = val->bus_bps / (float_t)bus_hz;
+    val->latency_us = ((wtm - 1U) * period) + conv +
+                      (uint32_t)((bits * 1000000.0f) / (float_t)bus_hz);
   }
+
   return ret;
 }
 
 /**
-  * @brief  Configuration of Wake-up and Wake-up to Sleep .[set]
+  * @}
   *
-  * @param  ctx   communication interface handler.(ptr)
-  * @param  val   parameters of configuration.(ptr)
-  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  */
+
+/**
+  * @defgroup     Asynchronous functions
+  * @brief        This section groups the non-blocking versions of the
+  *               main functions, built on ilps28qsw_priv_t async_read and
+  *               async_write. One operation per device can be in progress,
+  *               its completion is notified through the user callback.
+  * @{
   *
   */
-int32_t ilps28qsw_reference_mode_get(stmdev_ctx_t *ctx, ilps28qsw_ref_md_t *val)
+
+#define ILPS28QSW_ASYNC_IDLE      0U
+#define ILPS28QSW_ASYNC_FIFO      1U
+#define ILPS28QSW_ASYNC_DATA      2U
+#define ILPS28QSW_ASYNC_POLL      3U
+#define ILPS28QSW_ASYNC_MODE      4U
+
+static void async_finish(stmdev_ctx_t *ctx, ilps28qsw_async_t *op,
+                         int32_t status)
 {
-  ilps28qsw_interrupt_cfg_t interrupt_cfg;
-  int32_t ret;
+  ilps28qsw_priv_t *priv = priv_get(ctx);
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_INTERRUPT_CFG,
-                           (uint8_t *)&interrupt_cfg, 1);
+  op->op = ILPS28QSW_ASYNC_IDLE;
+  priv->async = NULL;
+  if (op->cb != NULL)
+  {
+    op->cb(ctx, status, op->arg);
+  }
+}
 
-  switch ((interrupt_cfg.reset_az << 1) |
-          interrupt_cfg.autorefp)
+/*
+ * Run the operation up to the next bus transfer; return the status of the
+ * transfer request, 0 also when the operation is finished.
+ */
+static int32_t async_run(stmdev_ctx_t *ctx, ilps28qsw_async_t *op)
+{
+  ilps28qsw_priv_t *priv = priv_get(ctx);
+  ilps28qsw_shadow_t *shadow;
+  uint16_t chunk;
+  uint16_t len = 0U;
+  uint8_t *data = NULL;
+  uint8_t reg = 0U;
+  uint8_t rd = 0U;
+  uint8_t i;
+  int32_t ret = 0;
+
+  op->wr_data = NULL;
+
+  switch (op->op)
   {
-    case ILPS28QSW_OUT_AND_INTERRUPT:
-      val->apply_ref = ILPS28QSW_OUT_AND_INTERRUPT;
+    case ILPS28QSW_ASYNC_FIFO:
+      if (op->done < op->samp)
+      {
+        chunk = (uint16_t)op->samp - op->done;
+        if (chunk > fifo_burst_max(ctx))
+        {
+          chunk = fifo_burst_max(ctx);
+        }
+        reg = ILPS28QSW_FIFO_DATA_OUT_PRESS_XL;
+        data = &((uint8_t *)op->out)[(uint16_t)op->done *
+                                     ILPS28QSW_FIFO_SAMPLE_LEN];
+        len = chunk * ILPS28QSW_FIFO_SAMPLE_LEN;
+        rd = 1U;
+        op->done += (uint8_t)chunk;
+      }
+      else
+      {
+        ilps28qsw_fifo_sample_pack(&op->md, (uint8_t *)op->out, op->samp,
+                                   (ilps28qsw_fifo_sample_t *)op->out);
+      }
       break;
-    case ILPS28QSW_ONLY_INTERRUPT:
-      val->apply_ref = ILPS28QSW_ONLY_INTERRUPT;
+
+    case ILPS28QSW_ASYNC_DATA:
+      if (op->step == 0U)
+      {
+        reg = ILPS28QSW_PRESS_OUT_XL;
+        data = op->reg;
+        len = 5U;
+        rd = 1U;
+      }
+      else
+      {
+        data_decode(&op->md, op->reg, (ilps28qsw_data_t *)op->out);
+      }
+      break;
+
+    case ILPS28QSW_ASYNC_POLL:
+      if (op->step == 0U)
+      {
+        reg = ILPS28QSW_INT_SOURCE;
+        data = op->reg;
+        len = 9U;
+        rd = 1U;
+      }
+      else
+      {
+        ilps28qsw_poll_snapshot_t *val = (ilps28qsw_poll_snapshot_t *)op->out;
+        ilps28qsw_int_source_t int_source;
+        ilps28qsw_status_t status;
+
+        bytecpy((uint8_t *)&int_source, &op->reg[0]);
+        bytecpy((uint8_t *)&status, &op->reg[3]);
+        sources_decode(op->reg, &val->sources);
+        val->boot       = int_source.boot_on;
+        val->ovr_pres   = status.p_or;
+        val->ovr_temp   = status.t_or;
+        val->fifo_level = op->reg[1];
+        data_decode(&op->md, &op->reg[4], &val->data);
+      }
+      break;
+
+    case ILPS28QSW_ASYNC_MODE:
+      if (op->step == 0U)
+      {
+        /* CTRL_REG1 .. FIFO_CTRL, from shadow copy when available */
+        shadow = shadow_get(ctx, ILPS28QSW_CTRL_REG1, 5U);
+        if ((shadow != NULL) && (shadow->valid == PROPERTY_ENABLE))
+        {
+          (void)ilps28qsw_cfg_read(ctx, ILPS28QSW_CTRL_REG1, op->reg, 5U);
+          mode_seq_build(&op->md, op->reg, &op->reg[5]);
+        }
+        else
+        {
+          reg = ILPS28QSW_CTRL_REG1;
+          data = op->reg;
+          len = 5U;
+          rd = 1U;
+        }
+        op->step = 1U;
+      }
+      else if (op->step == 1U)
+      {
+        mode_seq_build(&op->md, op->reg, &op->reg[5]);
+      }
+      else
+      {
+        /* write in progress */
+      }
+
+      if (data == NULL)
+      {
+        /* next enabled write of the mode_set sequence */
+        for (i = op->step - 1U; i < 5U; i++)
+        {
+          op->step++;
+          if (mode_seq_get(&op->reg[5], i, &reg, &data, &len) != 0U)
+          {
+            break;
+          }
+          data = NULL;
+        }
+      }
       break;
+
     default:
-      val->apply_ref = ILPS28QSW_RST_REFS;
+      ret = -1;
       break;
   }
-  val->get_ref = interrupt_cfg.autozero;
+
+  if (data == NULL)
+  {
+    async_finish(ctx, op, ret);
+  }
+  else
+  {
+    if (op->op != ILPS28QSW_ASYNC_MODE)
+    {
+      op->step++;
+    }
+    if (rd == 0U)
+    {
+      op->wr_reg = reg;
+      op->wr_data = data;
+      op->wr_len = len;
+      ret = priv->async_write(ctx->handle, reg, data, len);
+    }
+    else
+    {
+      ret = priv->async_read(ctx->handle, reg, data, len);
+    }
+#ifdef ILPS28QSW_BUS_STATS
+    /* counted on start, latency is not measured */
+    bus_stats_count(priv->stats, rd, reg, len, ret);
+#endif /* ILPS28QSW_BUS_STATS */
+  }
 
   return ret;
 }
 
+static int32_t async_start(stmdev_ctx_t *ctx, ilps28qsw_async_t *op,
+                           uint8_t id, ilps28qsw_md_t *md, void *out,
+                           ilps28qsw_async_cb_t cb, void *arg)
+{
+  ilps28qsw_priv_t *priv = priv_get(ctx);
+  int32_t ret = -1;
+
+  if ((priv != NULL) && (priv->async == NULL) &&
+      (priv->async_read != NULL) && (priv->async_write != NULL))
+  {
+    op->op = id;
+    op->step = 0U;
+    op->done = 0U;
+    op->md = *md;
+    op->out = out;
+    op->cb = cb;
+    op->arg = arg;
+    priv->async = op;
+
+    ret = async_run(ctx, op);
+    if ((ret != 0) && (priv->async == op))
+    {
+      /* first transfer not started: no callback */
+      op->op = ILPS28QSW_ASYNC_IDLE;
+      priv->async = NULL;
+    }
+  }
+
+  return ret;
+}
 
 /**
-  * @brief  Configuration of Wake-up and Wake-up to Sleep .[set]
+  * @brief  Bus transfer completed: continue the operation in progress.
+  *         To be called by the platform when the transfer started by
+  *         async_read / async_write is over.
   *
-  * @param  ctx   communication interface handler.(ptr)
-  * @param  val   parameters of configuration.(ptr)
-  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  * @param  ctx     communication interface handler.(ptr)
+  * @param  status  transfer status (0 -> no Error)
   *
   */
-int32_t ilps28qsw_opc_set(stmdev_ctx_t *ctx, int16_t val)
+void ilps28qsw_async_complete(stmdev_ctx_t *ctx, int32_t status)
 {
-  uint8_t reg[2];
-  int32_t ret;
+  ilps28qsw_priv_t *priv = priv_get(ctx);
+  ilps28qsw_async_t *op;
+  int32_t ret = status;
 
-  reg[1] = (uint8_t)(((uint16_t)val & 0xFF00U) / 256U);
-  reg[0] = (uint8_t)((uint16_t)val & 0x00FFU);
+  if ((priv != NULL) && (priv->async != NULL))
+  {
+    op = priv->async;
 
-  ret = ilps28qsw_write_reg(ctx, ILPS28QSW_RPDS_L, reg, 2);
+    if ((ret == 0) && (op->wr_data != NULL))
+    {
+      shadow_update(ctx, op->wr_reg, op->wr_data, op->wr_len);
+    }
 
-  return ret;
+    if (ret == 0)
+    {
+      ret = async_run(ctx, op);
+    }
+
+    if ((ret != 0) && (priv->async == op))
+    {
+      async_finish(ctx, op, ret);
+    }
+  }
 }
 
 /**
-  * @brief  Configuration of Wake-up and Wake-up to Sleep .[set]
+  * @brief  FIFO data read into compact samples, non-blocking.[get]
   *
   * @param  ctx   communication interface handler.(ptr)
-  * @param  val   parameters of configuration.(ptr)
-  * @retval       interface status (MANDATORY: return 0 -> no Error)
+  * @param  op    operation state, valid till the callback.(ptr)
+  * @param  samp  number of samples stored in FIFO.
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  data  compact FIFO samples, also used as burst buffer.(ptr)
+  * @param  cb    called when the operation is over.(ptr)
+  * @param  arg   user argument passed to cb.(ptr)
+  * @retval       0 -> operation started, cb will be called
   *
   */
-int32_t ilps28qsw_opc_get(stmdev_ctx_t *ctx, int16_t *val)
+int32_t ilps28qsw_fifo_sample_get_async(stmdev_ctx_t *ctx,
+                                        ilps28qsw_async_t *op, uint8_t samp,
+                                        ilps28qsw_md_t *md,
+                                        ilps28qsw_fifo_sample_t *data,
+                                        ilps28qsw_async_cb_t cb, void *arg)
 {
-  uint8_t reg[2];
-  int32_t ret;
+  op->samp = samp;
 
-  ret = ilps28qsw_read_reg(ctx, ILPS28QSW_RPDS_L, reg, 2);
+  return async_start(ctx, op, ILPS28QSW_ASYNC_FIFO, md, data, cb, arg);
+}
 
-  *val = (int16_t)reg[1];
-  *val = *val * 256 + (int16_t)reg[0];
+/**
+  * @brief  Output data read, non-blocking.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  op    operation state, valid till the callback.(ptr)
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  data  data retrived from the sensor.(ptr)
+  * @param  cb    called when the operation is over.(ptr)
+  * @param  arg   user argument passed to cb.(ptr)
+  * @retval       0 -> operation started, cb will be called
+  *
+  */
+int32_t ilps28qsw_data_get_async(stmdev_ctx_t *ctx, ilps28qsw_async_t *op,
+                                 ilps28qsw_md_t *md, ilps28qsw_data_t *data,
+                                 ilps28qsw_async_cb_t cb, void *arg)
+{
+  return async_start(ctx, op, ILPS28QSW_ASYNC_DATA, md, data, cb, arg);
+}
 
-  return ret;
+/**
+  * @brief  Device snapshot as ilps28qsw_poll_snapshot_get, non-blocking.[get]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  op    operation state, valid till the callback.(ptr)
+  * @param  md    the sensor conversion parameters.(ptr)
+  * @param  val   snapshot of the device.(ptr)
+  * @param  cb    called when the operation is over.(ptr)
+  * @param  arg   user argument passed to cb.(ptr)
+  * @retval       0 -> operation started, cb will be called
+  *
+  */
+int32_t ilps28qsw_poll_snapshot_get_async(stmdev_ctx_t *ctx,
+                                          ilps28qsw_async_t *op,
+                                          ilps28qsw_md_t *md,
+                                          ilps28qsw_poll_snapshot_t *val,
+                                          ilps28qsw_async_cb_t cb, void *arg)
+{
+  return async_start(ctx, op, ILPS28QSW_ASYNC_POLL, md, val, cb, arg);
 }
 
+/**
+  * @brief  Sensor conversion parameters selection, non-blocking.[set]
+  *
+  * @param  ctx   communication interface handler.(ptr)
+  * @param  op    operation state, valid till the callback.(ptr)
+  * @param  val   set the sensor conversion parameters.(ptr)
+  * @param  cb    called when the operation is over.(ptr)
+  * @param  arg   user argument passed to cb.(ptr)
+  * @retval       0 -> operation started, cb will be called
+  *
+  */
+int32_t ilps28qsw_mode_set_async(stmdev_ctx_t *ctx, ilps28qsw_async_t *op,
+                                 ilps28qsw_md_t *val,
+                                 ilps28qsw_async_cb_t cb, void *arg)
+{
+  return async_start(ctx, op, ILPS28QSW_ASYNC_MODE, val, NULL, cb, arg);
+}
 
 /**
   * @}
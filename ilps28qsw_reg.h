@@ -122,6 +122,10 @@ typedef struct
   stmdev_mdelay_ptr   mdelay;
   /** Customizable optional pointer **/
   void *handle;
+#ifdef ILPS28QSW_PRIV_DATA
+  /** private data **/
+  void *priv_data;
+#endif /* ILPS28QSW_PRIV_DATA */
 } stmdev_ctx_t;
 
 /**
@@ -473,16 +477,61 @@ int32_t ilps28qsw_read_reg(stmdev_ctx_t *ctx, uint8_t reg,
 int32_t ilps28qsw_write_reg(stmdev_ctx_t *ctx, uint8_t reg,
                             uint8_t *data, uint16_t len);
 
+/** Shadow copy of configuration registers INTERRUPT_CFG .. I3C_IF_CTRL **/
+#define ILPS28QSW_SHADOW_FIRST            ILPS28QSW_INTERRUPT_CFG
+#define ILPS28QSW_SHADOW_LAST             ILPS28QSW_I3C_IF_CTRL
+#define ILPS28QSW_SHADOW_LEN              15U
+
+/* Cached bits: self-clearing bits are never stored */
+#define ILPS28QSW_INTERRUPT_CFG_KEEP      0xAFU /* not reset_arp, reset_az */
+#define ILPS28QSW_CTRL_REG2_KEEP          0x7AU /* not boot, swreset, oneshot */
+#define ILPS28QSW_CTRL_REG2_RELOAD        0x84U /* boot, swreset */
+
+typedef struct
+{
+  uint8_t reg[ILPS28QSW_SHADOW_LEN];
+  uint8_t valid;
+} ilps28qsw_shadow_t;
+
+int32_t ilps28qsw_shadow_sync(stmdev_ctx_t *ctx);
+
+/*
+ * Configuration snapshot of INTERRUPT_CFG .. I3C_IF_CTRL, e.g. saved
+ * before the host deep-sleep and checked by ilps28qsw_resume() at wake-up
+ * while the sensor stayed powered.
+ */
+typedef struct
+{
+  uint8_t reg[ILPS28QSW_SHADOW_LEN];
+} ilps28qsw_cfg_snap_t;
+
+int32_t ilps28qsw_cfg_snap_save(stmdev_ctx_t *ctx, ilps28qsw_cfg_snap_t *snap);
+int32_t ilps28qsw_resume(stmdev_ctx_t *ctx, const ilps28qsw_cfg_snap_t *snap);
+void ilps28qsw_shadow_invalidate(stmdev_ctx_t *ctx);
+
+#ifndef ILPS28QSW_UCF_BURST_MAX
+#define ILPS28QSW_UCF_BURST_MAX           ILPS28QSW_SHADOW_LEN
+#endif /* ILPS28QSW_UCF_BURST_MAX */
+
+int32_t ilps28qsw_ucf_load(stmdev_ctx_t *ctx, const ucf_line_t *ucf,
+                           uint16_t len, uint8_t skip_cached);
+
 extern float_t ilps28qsw_from_fs1260_to_hPa(int32_t lsb);
 extern float_t ilps28qsw_from_fs4000_to_hPa(int32_t lsb);
 
 extern float_t ilps28qsw_from_lsb_to_celsius(int16_t lsb);
 
+extern int32_t ilps28qsw_from_fs1260_to_cPa(int32_t lsb);
+extern int32_t ilps28qsw_from_fs4000_to_cPa(int32_t lsb);
+
+extern int16_t ilps28qsw_from_lsb_to_cdeg_c(int16_t lsb);
+
 typedef struct
 {
   uint8_t whoami;
 } ilps28qsw_id_t;
 int32_t ilps28qsw_id_get(stmdev_ctx_t *ctx, ilps28qsw_id_t *val);
+uint8_t ilps28qsw_discover(stmdev_ctx_t *ctx, uint8_t n, uint8_t *found);
 
 typedef struct
 {
@@ -581,6 +630,21 @@ int32_t ilps28qsw_mode_get(stmdev_ctx_t *ctx, ilps28qsw_md_t *val);
 
 int32_t ilps28qsw_trigger_sw(stmdev_ctx_t *ctx, ilps28qsw_md_t *md);
 
+#ifndef ILPS28QSW_ONE_SHOT_RETRY
+#define ILPS28QSW_ONE_SHOT_RETRY  4U /* 1 ms polls after expected time */
+#endif /* ILPS28QSW_ONE_SHOT_RETRY */
+
+/*
+ * Interleaved mode: pressure and AH_QVAR are converted in turn in each ODR
+ * period, so FIFO receives ILPS28QSW_INTERLEAVED_ENTRIES entries per ODR
+ * period, one per stream.
+ */
+#define ILPS28QSW_INTERLEAVED_ENTRIES     2U
+
+uint32_t ilps28qsw_conv_time_us(ilps28qsw_md_t *md);
+int32_t ilps28qsw_one_shot_start(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                                 uint32_t *wait_us);
+
 typedef struct
 {
   struct
@@ -600,6 +664,42 @@ typedef struct
 } ilps28qsw_data_t;
 int32_t ilps28qsw_data_get(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
                            ilps28qsw_data_t *data);
+int32_t ilps28qsw_one_shot_fetch(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                                 ilps28qsw_data_t *data, uint8_t *ready);
+int32_t ilps28qsw_one_shot_get(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                               ilps28qsw_data_t *data, uint8_t *ready);
+
+typedef struct
+{
+  struct
+  {
+    int32_t cpa; /* pressure in 0.01 Pa */
+    int32_t raw; /* 32 bit signed-left algned  format left  */
+  } pressure;
+  struct
+  {
+    int16_t cdeg_c; /* temperature in 0.01 degC */
+    int16_t raw;
+  } heat;
+  struct
+  {
+    int32_t lsb; /* 24 bit properly right aligned */
+  } ah_qvar;
+} ilps28qsw_data_fixed_t;
+int32_t ilps28qsw_data_fixed_get(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                                 ilps28qsw_data_fixed_t *data);
+
+typedef struct
+{
+  ilps28qsw_all_sources_t sources;
+  uint8_t boot      : 1; /* Restoring calibration parameters. */
+  uint8_t ovr_pres  : 1; /* Pressure data overrun. */
+  uint8_t ovr_temp  : 1; /* Temperature data overrun. */
+  uint8_t fifo_level;    /* Number of samples stored in FIFO. */
+  ilps28qsw_data_t data;
+} ilps28qsw_poll_snapshot_t;
+int32_t ilps28qsw_poll_snapshot_get(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                                    ilps28qsw_poll_snapshot_t *val);
 typedef struct
 {
   int32_t lsb; /* 24 bit properly right aligned */
@@ -626,6 +726,22 @@ int32_t ilps28qsw_fifo_mode_get(stmdev_ctx_t *ctx, ilps28qsw_fifo_md_t *val);
 
 int32_t ilps28qsw_fifo_level_get(stmdev_ctx_t *ctx, uint8_t *val);
 
+/** Max number of FIFO samples fetched with a single bus burst read
+  * (3 bytes per sample). Lower it if the platform limits transfer size.
+  */
+#ifndef ILPS28QSW_FIFO_BURST_MAX
+#define ILPS28QSW_FIFO_BURST_MAX          128U
+#endif /* ILPS28QSW_FIFO_BURST_MAX */
+
+/** Number of FIFO samples fetched per burst by ilps28qsw_fifo_data_get
+  * (sizes a 3 * ILPS28QSW_FIFO_DATA_CHUNK bytes buffer on the stack).
+  */
+#ifndef ILPS28QSW_FIFO_DATA_CHUNK
+#define ILPS28QSW_FIFO_DATA_CHUNK         16U
+#endif /* ILPS28QSW_FIFO_DATA_CHUNK */
+
+#define ILPS28QSW_FIFO_SAMPLE_LEN         3U
+
 typedef struct
 {
   float_t hpa;
@@ -634,6 +750,354 @@ typedef struct
 } ilps28qsw_fifo_data_t;
 int32_t ilps28qsw_fifo_data_get(stmdev_ctx_t *ctx, uint8_t samp,
                                 ilps28qsw_md_t *md, ilps28qsw_fifo_data_t *data);
+int32_t ilps28qsw_fifo_raw_data_get(stmdev_ctx_t *ctx, uint8_t samp,
+                                    uint8_t *buff);
+void ilps28qsw_fifo_data_decode(ilps28qsw_md_t *md, const uint8_t *buff,
+                                uint8_t samp, ilps28qsw_fifo_data_t *data);
+
+typedef struct
+{
+  int32_t cpa; /* pressure in 0.01 Pa */
+  int32_t lsb; /* 24 bit properly right aligned */
+  int32_t raw;
+} ilps28qsw_fifo_data_fixed_t;
+int32_t ilps28qsw_fifo_data_fixed_get(stmdev_ctx_t *ctx, uint8_t samp,
+                                      ilps28qsw_md_t *md,
+                                      ilps28qsw_fifo_data_fixed_t *data);
+void ilps28qsw_fifo_data_fixed_decode(ilps28qsw_md_t *md, const uint8_t *buff,
+                                      uint8_t samp,
+                                      ilps28qsw_fifo_data_fixed_t *data);
+
+/*
+ * Compact FIFO sample: [23:0] PRESS_H:PRESS_L:PRESS_XL raw value,
+ * [24] set for AH_QVAR samples (interleaved mode). Convert on access.
+ */
+typedef uint32_t ilps28qsw_fifo_sample_t;
+#define ILPS28QSW_FIFO_SAMPLE_QVAR        0x01000000U
+
+int32_t ilps28qsw_fifo_sample_get(stmdev_ctx_t *ctx, uint8_t samp,
+                                  ilps28qsw_md_t *md,
+                                  ilps28qsw_fifo_sample_t *data);
+void ilps28qsw_fifo_sample_pack(ilps28qsw_md_t *md, const uint8_t *buff,
+                                uint8_t samp, ilps28qsw_fifo_sample_t *data);
+uint8_t ilps28qsw_fifo_sample_is_qvar(ilps28qsw_fifo_sample_t val);
+int32_t ilps28qsw_fifo_sample_raw(ilps28qsw_fifo_sample_t val);
+float_t ilps28qsw_fifo_sample_to_hPa(ilps28qsw_md_t *md,
+                                     ilps28qsw_fifo_sample_t val);
+int32_t ilps28qsw_fifo_sample_to_cPa(ilps28qsw_md_t *md,
+                                     ilps28qsw_fifo_sample_t val);
+int32_t ilps28qsw_fifo_sample_to_qvar(ilps28qsw_fifo_sample_t val);
+
+/*
+ * Lock-free single-producer / single-consumer ring of compact samples:
+ * the producer (e.g. FIFO watermark ISR) only writes head, the consumer
+ * (task) only writes tail. ILPS28QSW_RING_SIZE must be a power of two,
+ * max 32768.
+ */
+#ifndef ILPS28QSW_RING_SIZE
+#define ILPS28QSW_RING_SIZE               256U
+#endif /* ILPS28QSW_RING_SIZE */
+
+/** Memory barrier between ring data and index updates (e.g. __DMB()) **/
+#ifndef ILPS28QSW_RING_BARRIER
+#if defined(__GNUC__)
+#define ILPS28QSW_RING_BARRIER()          __sync_synchronize()
+#else
+#define ILPS28QSW_RING_BARRIER()
+#endif /* __GNUC__ */
+#endif /* ILPS28QSW_RING_BARRIER */
+
+typedef struct
+{
+  volatile uint16_t head; /* samples pushed, written by producer only */
+  volatile uint16_t tail; /* samples popped, written by consumer only */
+  ilps28qsw_fifo_sample_t buf[ILPS28QSW_RING_SIZE];
+} ilps28qsw_ring_t;
+
+void ilps28qsw_ring_init(ilps28qsw_ring_t *ring);
+uint16_t ilps28qsw_ring_count(ilps28qsw_ring_t *ring);
+uint16_t ilps28qsw_ring_push(ilps28qsw_ring_t *ring,
+                             const ilps28qsw_fifo_sample_t *data, uint16_t n);
+uint16_t ilps28qsw_ring_pop(ilps28qsw_ring_t *ring,
+                            ilps28qsw_fifo_sample_t *data, uint16_t n);
+int32_t ilps28qsw_fifo_ring_drain(stmdev_ctx_t *ctx, uint8_t samp,
+                                  ilps28qsw_md_t *md, ilps28qsw_ring_t *ring,
+                                  uint8_t *stored);
+
+typedef struct
+{
+  uint8_t level;         /* samples stored in FIFO when serviced */
+  uint8_t stored;        /* samples read from FIFO */
+  uint8_t fifo_th   : 1; /* FIFO threshold reached */
+  uint8_t fifo_ovr  : 1; /* FIFO overrun: samples lost */
+  uint8_t fifo_full : 1; /* FIFO full */
+} ilps28qsw_fifo_srv_t;
+int32_t ilps28qsw_fifo_service(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                               ilps28qsw_fifo_sample_t *data, uint8_t max,
+                               ilps28qsw_fifo_srv_t *val);
+int32_t ilps28qsw_fifo_ring_service(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                                    ilps28qsw_ring_t *ring,
+                                    ilps28qsw_fifo_srv_t *val);
+int32_t ilps28qsw_event_service(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                                ilps28qsw_ring_t *ring,
+                                ilps28qsw_poll_snapshot_t *snap,
+                                uint8_t *stored);
+
+/*
+ * Interleaved mode demultiplexer: splits a raw FIFO burst into pressure
+ * and AH_QVAR streams. The state is kept across bursts, so a pair split
+ * at a FIFO boundary keeps the same sequence index on both streams.
+ */
+typedef struct
+{
+  uint32_t press_seq; /* sequence index of the next pressure sample */
+  uint32_t qvar_seq;  /* sequence index of the next AH_QVAR sample */
+  uint32_t lost;      /* samples missing from pressure/AH_QVAR alternation */
+  uint8_t last;       /* 0: none, 1: pressure, 2: AH_QVAR (internal) */
+} ilps28qsw_demux_t;
+
+typedef struct
+{
+  int32_t *val;   /* pressure: 32 bit signed-left aligned raw,
+                   * AH_QVAR: 24 bit properly right aligned */
+  uint32_t *seq;  /* sequence index of each sample, NULL to skip */
+  uint16_t max;   /* size of val (and seq) */
+  uint16_t count; /* samples written by last call */
+} ilps28qsw_demux_stream_t;
+
+void ilps28qsw_demux_init(ilps28qsw_demux_t *dmx);
+uint16_t ilps28qsw_fifo_demux(ilps28qsw_demux_t *dmx, const uint8_t *buff,
+                              uint16_t samp, ilps28qsw_demux_stream_t *press,
+                              ilps28qsw_demux_stream_t *qvar);
+
+/*
+ * FIFO samples timestamping: FIFO entries are one ODR period apart, or
+ * 1 / ILPS28QSW_INTERLEAVED_ENTRIES of it in interleaved mode, where
+ * pressure and AH_QVAR entries alternate. The entry period is tracked
+ * against the host clock (us) from batch to batch.
+ */
+typedef struct
+{
+  uint32_t period;  /* estimated period between FIFO entries, us * 256 */
+  uint32_t nominal; /* period expected from ODR and interleaved mode,
+                     * us * 256 */
+  uint32_t last_ts; /* host time of the last reference sample, us */
+  uint16_t pending; /* entries after the last reference sample */
+  uint8_t valid;    /* last_ts is valid */
+  uint8_t shift;    /* each new estimate weights 1 / 2^shift */
+} ilps28qsw_ts_t;
+
+int32_t ilps28qsw_ts_init(ilps28qsw_ts_t *ts, ilps28qsw_md_t *md,
+                          uint8_t shift);
+void ilps28qsw_ts_batch(ilps28qsw_ts_t *ts, uint32_t irq_ts, uint8_t ref,
+                        uint8_t samp, uint32_t *stamp);
+int32_t ilps28qsw_ts_drift_ppm(ilps28qsw_ts_t *ts);
+
+/*
+ * Watermark scheduler: the watermark is the largest batch meeting the
+ * latency budget that still leaves room in FIFO for the host wake-up
+ * time plus a margin, which is tuned back on overrun and latency miss.
+ */
+#ifndef ILPS28QSW_WTM_MARGIN_MAX
+#define ILPS28QSW_WTM_MARGIN_MAX   32U
+#endif /* ILPS28QSW_WTM_MARGIN_MAX */
+#ifndef ILPS28QSW_WTM_RELAX
+#define ILPS28QSW_WTM_RELAX        64U /* clean batches before relax */
+#endif /* ILPS28QSW_WTM_RELAX */
+
+typedef struct
+{
+  uint32_t latency_us; /* max delay from sample conversion to host */
+  uint32_t wake_us;    /* host wake-up and FIFO service cost */
+  uint16_t clean;      /* batches since the last miss */
+  uint8_t margin;      /* FIFO entries held in reserve */
+  uint8_t watermark;   /* last programmed watermark (0 bypass) */
+} ilps28qsw_wtm_sched_t;
+
+void ilps28qsw_wtm_sched_init(ilps28qsw_wtm_sched_t *sched,
+                              uint32_t latency_us, uint32_t wake_us);
+int32_t ilps28qsw_wtm_sched_apply(stmdev_ctx_t *ctx,
+                                  ilps28qsw_wtm_sched_t *sched,
+                                  ilps28qsw_md_t *md);
+int32_t ilps28qsw_wtm_sched_feedback(stmdev_ctx_t *ctx,
+                                     ilps28qsw_wtm_sched_t *sched,
+                                     ilps28qsw_md_t *md, uint8_t ovr,
+                                     uint8_t late);
+
+/*
+ * Multi-device manager: devices are grouped by physical bus and each bus
+ * is serviced by its own loop (task or thread) calling
+ * ilps28qsw_mgr_service, so transactions never compete on a bus while
+ * different buses run in parallel.
+ */
+#ifndef ILPS28QSW_MGR_MAX
+#define ILPS28QSW_MGR_MAX                 16U
+#endif /* ILPS28QSW_MGR_MAX */
+#ifndef ILPS28QSW_MGR_BUS_MAX
+#define ILPS28QSW_MGR_BUS_MAX             4U
+#endif /* ILPS28QSW_MGR_BUS_MAX */
+#define ILPS28QSW_MGR_ALL_BUSES           0xFFU
+
+typedef struct
+{
+  stmdev_ctx_t *ctx;
+  ilps28qsw_md_t md;
+  ilps28qsw_ring_t *ring;    /* destination of the FIFO samples */
+  ilps28qsw_fifo_srv_t srv;  /* result of the last service */
+  uint32_t period;           /* service period (us), e.g. watermark / ODR */
+  uint32_t deadline;         /* host time (us) of the next service */
+  uint8_t bus;               /* physical bus */
+  volatile uint8_t pending;  /* FIFO interrupt notified */
+} ilps28qsw_mgr_dev_t;
+
+typedef struct
+{
+  ilps28qsw_mgr_dev_t dev[ILPS28QSW_MGR_MAX];
+  uint8_t next[ILPS28QSW_MGR_BUS_MAX]; /* round-robin position per bus */
+  uint8_t count;
+  enum
+  {
+    ILPS28QSW_MGR_ROUND_ROBIN = 0, /* pending or due devices in turn */
+    ILPS28QSW_MGR_DEADLINE    = 1, /* earliest deadline first */
+  } policy;
+} ilps28qsw_mgr_t;
+
+void ilps28qsw_mgr_init(ilps28qsw_mgr_t *mgr, uint8_t policy);
+int32_t ilps28qsw_mgr_add(ilps28qsw_mgr_t *mgr, stmdev_ctx_t *ctx,
+                          ilps28qsw_md_t *md, ilps28qsw_ring_t *ring,
+                          uint8_t bus, uint32_t period);
+void ilps28qsw_mgr_notify(ilps28qsw_mgr_t *mgr, uint8_t idx);
+int32_t ilps28qsw_mgr_service(ilps28qsw_mgr_t *mgr, uint8_t bus,
+                              uint32_t now, int32_t *idx);
+int32_t ilps28qsw_mgr_poll(ilps28qsw_mgr_t *mgr, uint8_t bus,
+                           ilps28qsw_poll_snapshot_t *val);
+
+/*
+ * Triggered capture: FIFO is armed in a trigger mode (interrupt event as
+ * trigger) and drained once frozen, full or at watermark, as raw
+ * 3 bytes samples in the caller buffer.
+ */
+#define ILPS28QSW_CAPTURE_PRE_UNKNOWN     0xFFU
+
+typedef struct
+{
+  ilps28qsw_fifo_md_t fifo; /* trigger mode, watermark (0 full FIFO) */
+  uint8_t pre;              /* samples stored before the trigger */
+  uint8_t level;            /* samples captured */
+  uint8_t triggered;        /* trigger event seen */
+} ilps28qsw_capture_t;
+
+int32_t ilps28qsw_capture_arm(stmdev_ctx_t *ctx, ilps28qsw_capture_t *cap);
+int32_t ilps28qsw_capture_mark(stmdev_ctx_t *ctx, ilps28qsw_capture_t *cap);
+int32_t ilps28qsw_capture_poll(stmdev_ctx_t *ctx, ilps28qsw_capture_t *cap,
+                               uint8_t *frozen);
+int32_t ilps28qsw_capture_read(stmdev_ctx_t *ctx, ilps28qsw_capture_t *cap,
+                               uint8_t *buff, uint16_t len);
+
+/*
+ * AH_QVAR streaming: AH_QVAR only (not interleaved) stored in FIFO, with
+ * an incremental detector of touch events: EMA baseline frozen during
+ * the event, threshold on the distance from baseline and debounce.
+ */
+#define ILPS28QSW_QVAR_EV_NONE            0U
+#define ILPS28QSW_QVAR_EV_ON              1U
+#define ILPS28QSW_QVAR_EV_OFF             2U
+
+typedef struct
+{
+  int32_t baseline;    /* lsb * 256 */
+  int32_t threshold;   /* lsb from baseline */
+  uint8_t shift;       /* baseline EMA weight 1 / 2^shift */
+  uint8_t on_count;    /* samples over threshold to start an event */
+  uint8_t off_count;   /* samples under threshold to end an event */
+  uint8_t cnt;
+  uint8_t active;
+  uint8_t init;
+} ilps28qsw_qvar_det_t;
+
+typedef struct
+{
+  uint8_t level;       /* samples read from FIFO */
+  uint8_t on;          /* events started */
+  uint8_t off;         /* events ended */
+  uint8_t active : 1;  /* event in progress after the last sample */
+  uint8_t fifo_ovr : 1;
+} ilps28qsw_qvar_srv_t;
+
+int32_t ilps28qsw_qvar_stream_start(stmdev_ctx_t *ctx, ilps28qsw_md_t *md,
+                                    uint8_t watermark);
+void ilps28qsw_qvar_det_init(ilps28qsw_qvar_det_t *det, int32_t threshold,
+                             uint8_t shift, uint8_t on_count,
+                             uint8_t off_count);
+uint8_t ilps28qsw_qvar_det_update(ilps28qsw_qvar_det_t *det, int32_t lsb);
+int32_t ilps28qsw_qvar_stream_service(stmdev_ctx_t *ctx,
+                                      ilps28qsw_qvar_det_t *det,
+                                      ilps28qsw_qvar_srv_t *val);
+
+/*
+ * Structure-of-arrays decoder for raw FIFO dumps (3 bytes per sample).
+ * Define ILPS28QSW_USE_SSSE3 on x86 hosts built with SSSE3 support to
+ * enable the SIMD byte assembly kernel.
+ */
+void ilps28qsw_fifo_batch_decode(ilps28qsw_md_t *md, const uint8_t *buff,
+                                 uint16_t samp, int32_t *raw, float_t *hpa,
+                                 int32_t *qvar);
+
+/*
+ * Altitude stage: barometric formula (ISA, 1013.25 hPa at sea level) by
+ * linear interpolation of a 8 hPa step table from 256 hPa to 1280 hPa,
+ * in fixed point. Pressure is handled in hPa Q12 (4096 = 1 hPa),
+ * altitude in mm.
+ */
+typedef struct
+{
+  int32_t offset;      /* added to pressure, hPa Q12 */
+  int32_t ref_q12;     /* reference pressure of deltas, hPa Q12 */
+  int32_t ref_mm;      /* reference altitude, mm */
+  uint32_t n;          /* running statistics of relative altitude */
+  int64_t sum;
+  int64_t sumsq;
+  uint8_t fs_4060;
+  uint8_t interleaved;
+} ilps28qsw_alt_t;
+
+void ilps28qsw_alt_init(ilps28qsw_alt_t *alt, ilps28qsw_md_t *md);
+int32_t ilps28qsw_alt_opc_load(stmdev_ctx_t *ctx, ilps28qsw_alt_t *alt);
+int32_t ilps28qsw_alt_from_q12(int32_t q12);
+void ilps28qsw_alt_reference_set(ilps28qsw_alt_t *alt, int32_t lsb);
+uint16_t ilps28qsw_alt_batch(ilps28qsw_alt_t *alt, const uint8_t *buff,
+                             uint16_t samp, int32_t *alt_mm, int32_t *delta);
+void ilps28qsw_alt_stats_get(ilps28qsw_alt_t *alt, int32_t *mean,
+                             uint32_t *var);
+
+/*
+ * Telemetry encoding of raw FIFO dumps: a ILPS28QSW_TLM_HDR_LEN bytes
+ * header (fs, interleaved, odr, avg, lpf) followed by one varint per
+ * sample, zig-zag first order delta. In interleaved mode pressure and
+ * AH_QVAR are separate delta streams, the stream is the varint bit 0.
+ * Decoding restores the raw FIFO bytes, e.g. for
+ * ilps28qsw_fifo_batch_decode().
+ */
+#define ILPS28QSW_TLM_VERSION             1U
+#define ILPS28QSW_TLM_HDR_LEN             3U
+#define ILPS28QSW_TLM_SAMPLE_MAX          4U /* varint bytes per sample */
+
+typedef struct
+{
+  int32_t last[2];     /* previous sample, pressure and AH_QVAR streams */
+  uint8_t interleaved;
+} ilps28qsw_tlm_t;
+
+void ilps28qsw_tlm_enc_init(ilps28qsw_tlm_t *tlm, ilps28qsw_md_t *md,
+                            uint8_t *hdr);
+uint16_t ilps28qsw_tlm_encode(ilps28qsw_tlm_t *tlm, const uint8_t *buff,
+                              uint16_t samp, uint8_t *out, uint16_t len,
+                              uint16_t *used);
+int32_t ilps28qsw_tlm_dec_init(ilps28qsw_tlm_t *tlm, const uint8_t *hdr,
+                               ilps28qsw_md_t *md);
+int32_t ilps28qsw_tlm_decode(ilps28qsw_tlm_t *tlm, const uint8_t *in,
+                             uint16_t len, uint8_t *buff, uint16_t samp,
+                             uint16_t *decoded, uint16_t *used);
 
 typedef struct
 {
@@ -679,6 +1143,240 @@ int32_t ilps28qsw_reference_mode_get(stmdev_ctx_t *ctx,
 int32_t ilps28qsw_opc_set(stmdev_ctx_t *ctx, int16_t val);
 int32_t ilps28qsw_opc_get(stmdev_ctx_t *ctx, int16_t *val);
 
+/*
+ * Delta wake-up: the threshold interrupt fires on a pressure change of
+ * delta_hpa from the pressure at arm time (AUTOREFP) and is re-armed
+ * after each event. The callback receives +1 over, -1 under.
+ */
+typedef void (*ilps28qsw_th_cb_t)(stmdev_ctx_t *ctx, int8_t dir,
+                                  ilps28qsw_poll_snapshot_t *snap, void *arg);
+
+typedef struct
+{
+  ilps28qsw_md_t md;
+  float_t delta_hpa;   /* pressure change raising an event */
+  float_t hyst_hpa;    /* extra change required on direction reversal */
+  ilps28qsw_th_cb_t cb;
+  void *arg;
+  float_t ref_hpa;     /* pressure of the last event */
+  int8_t last_dir;     /* direction of the last event, 0 none */
+} ilps28qsw_th_engine_t;
+
+int32_t ilps28qsw_th_engine_start(stmdev_ctx_t *ctx,
+                                  ilps28qsw_th_engine_t *eng);
+int32_t ilps28qsw_th_engine_event(stmdev_ctx_t *ctx,
+                                  ilps28qsw_th_engine_t *eng);
+
+/*
+ * Device profile: the settings of ilps28qsw_init_set(ILPS28QSW_DRV_RDY),
+ * bus_mode, pin_conf, mode, fifo_mode, interrupt_mode, int_on_threshold
+ * and reference setters compiled into a register write plan.
+ */
+typedef struct
+{
+  ilps28qsw_md_t md;
+  ilps28qsw_fifo_md_t fifo;
+  ilps28qsw_int_mode_t int_mode;
+  ilps28qsw_int_th_md_t int_th;
+  ilps28qsw_ref_md_t ref;
+  ilps28qsw_pin_conf_t pin;
+  ilps28qsw_bus_mode_t bus;
+  uint8_t ah_qvar_en;
+} ilps28qsw_profile_t;
+
+#define ILPS28QSW_PLAN_MAX                13U
+
+typedef struct
+{
+  ucf_line_t line[ILPS28QSW_PLAN_MAX];
+  uint8_t len;
+} ilps28qsw_plan_t;
+
+void ilps28qsw_plan_build(const ilps28qsw_profile_t *prof,
+                          ilps28qsw_plan_t *plan);
+int32_t ilps28qsw_plan_apply(stmdev_ctx_t *ctx, const ilps28qsw_plan_t *plan);
+
+/*
+ * Configuration estimator. Supply current: power-down current plus active
+ * current over the conversion time. Noise: typical RMS noise at 4 averages
+ * and LPF disabled, scaled by 1 / sqrt(averages) and by the LPF bandwidth.
+ * Bus: ILPS28QSW_EST_TX_BITS framing bits (address, register, start,
+ * restart, stop) plus 9 bits per byte, with the transactions of
+ * ilps28qsw_data_get() in bypass and of ilps28qsw_fifo_ring_service()
+ * otherwise. Define the coefficients to override the typical values.
+ */
+#ifndef ILPS28QSW_EST_IDD_PD_UA
+#define ILPS28QSW_EST_IDD_PD_UA           0.5f
+#endif /* ILPS28QSW_EST_IDD_PD_UA */
+#ifndef ILPS28QSW_EST_IDD_ACT_UA
+#define ILPS28QSW_EST_IDD_ACT_UA          600.0f
+#endif /* ILPS28QSW_EST_IDD_ACT_UA */
+#ifndef ILPS28QSW_EST_NOISE_PA
+#define ILPS28QSW_EST_NOISE_PA            2.6f   /* 1260 hPa full scale */
+#endif /* ILPS28QSW_EST_NOISE_PA */
+#ifndef ILPS28QSW_EST_NOISE_4060_GAIN
+#define ILPS28QSW_EST_NOISE_4060_GAIN     2.0f
+#endif /* ILPS28QSW_EST_NOISE_4060_GAIN */
+#ifndef ILPS28QSW_EST_TX_BITS
+#define ILPS28QSW_EST_TX_BITS             30U
+#endif /* ILPS28QSW_EST_TX_BITS */
+
+typedef struct
+{
+  float_t idd_ua;      /* sensor supply current */
+  float_t noise_pa;    /* pressure RMS noise */
+  float_t press_hz;    /* pressure samples per second */
+  float_t wakeup_hz;   /* host wake-ups per second */
+  float_t tx_hz;       /* bus transactions per second */
+  float_t bus_bps;     /* bus bits per second */
+  float_t bus_load;    /* fraction of the bus clock used */
+  uint32_t latency_us; /* worst case, conversion start to data in host */
+} ilps28qsw_est_t;
+
+int32_t ilps28qsw_estimate(ilps28qsw_md_t *md, ilps28qsw_fifo_md_t *fifo,
+                           uint32_t bus_hz, uint16_t burst,
+                           ilps28qsw_est_t *val);
+
+/*
+ * Batched bus transfers: the platform routine runs the n transfers in the
+ * given order with a single bus operation (e.g. one Linux I2C_RDWR ioctl
+ * with a write + read message pair per read, or one SPI_IOC_MESSAGE).
+ * Without it the driver issues the transfers one by one.
+ */
+typedef struct
+{
+  uint8_t reg;
+  uint8_t rd;       /* 1 read, 0 write */
+  uint16_t len;
+  uint8_t *data;
+} ilps28qsw_xfer_t;
+
+typedef int32_t (*ilps28qsw_xfer_ptr)(void *, ilps28qsw_xfer_t *, uint8_t);
+
+/*
+ * Non-blocking bus transfers (e.g. DMA): the platform routine starts the
+ * transfer and returns 0, then ilps28qsw_async_complete() must be called
+ * with the transfer status when it is over (e.g. from the DMA ISR).
+ */
+typedef int32_t (*ilps28qsw_async_write_ptr)(void *, uint8_t, const uint8_t *,
+                                             uint16_t);
+typedef int32_t (*ilps28qsw_async_read_ptr)(void *, uint8_t, uint8_t *,
+                                            uint16_t);
+typedef void (*ilps28qsw_async_cb_t)(stmdev_ctx_t *ctx, int32_t status,
+                                     void *arg);
+
+typedef struct
+{
+  /* internal state, do not modify while the operation is in progress */
+  uint8_t op;
+  uint8_t step;
+  uint8_t samp;
+  uint8_t done;
+  uint8_t reg[15];
+  uint8_t wr_reg;
+  uint16_t wr_len;
+  uint8_t *wr_data;
+  ilps28qsw_md_t md;
+  void *out;
+  ilps28qsw_async_cb_t cb;
+  void *arg;
+} ilps28qsw_async_t;
+
+int32_t ilps28qsw_fifo_sample_get_async(stmdev_ctx_t *ctx,
+                                        ilps28qsw_async_t *op, uint8_t samp,
+                                        ilps28qsw_md_t *md,
+                                        ilps28qsw_fifo_sample_t *data,
+                                        ilps28qsw_async_cb_t cb, void *arg);
+int32_t ilps28qsw_data_get_async(stmdev_ctx_t *ctx, ilps28qsw_async_t *op,
+                                 ilps28qsw_md_t *md, ilps28qsw_data_t *data,
+                                 ilps28qsw_async_cb_t cb, void *arg);
+int32_t ilps28qsw_poll_snapshot_get_async(stmdev_ctx_t *ctx,
+                                          ilps28qsw_async_t *op,
+                                          ilps28qsw_md_t *md,
+                                          ilps28qsw_poll_snapshot_t *val,
+                                          ilps28qsw_async_cb_t cb, void *arg);
+int32_t ilps28qsw_mode_set_async(stmdev_ctx_t *ctx, ilps28qsw_async_t *op,
+                                 ilps28qsw_md_t *val,
+                                 ilps28qsw_async_cb_t cb, void *arg);
+void ilps28qsw_async_complete(stmdev_ctx_t *ctx, int32_t status);
+
+#ifdef ILPS28QSW_BUS_STATS
+/*
+ * Bus instrumentation, built only with ILPS28QSW_BUS_STATS defined (and
+ * ILPS28QSW_PRIV_DATA, the counters are reached through ilps28qsw_priv_t).
+ * Transactions are counted by start register: INTERRUPT_CFG .. TEMP_OUT_H,
+ * FIFO data output and any other register. A batched transfer counts each
+ * of its transfers, but one latency sample and at most one error.
+ */
+#define ILPS28QSW_STATS_FIFO              34U
+#define ILPS28QSW_STATS_OTHER             35U
+#define ILPS28QSW_STATS_SLOTS             36U
+#define ILPS28QSW_STATS_BINS              32U
+
+typedef uint32_t (*ilps28qsw_cycles_ptr)(void);
+
+typedef struct
+{
+  ilps28qsw_cycles_ptr cycles; /* free running counter, NULL no latency */
+  uint32_t rd;                 /* read transactions */
+  uint32_t wr;                 /* write transactions */
+  uint32_t rd_bytes;
+  uint32_t wr_bytes;
+  uint32_t err;                /* transactions or batches in error */
+  uint32_t slot_rd[ILPS28QSW_STATS_SLOTS];
+  uint32_t slot_wr[ILPS28QSW_STATS_SLOTS];
+  uint32_t lat[ILPS28QSW_STATS_BINS]; /* bin n: 2^n <= cycles < 2^(n+1) */
+} ilps28qsw_bus_stats_t;
+
+void ilps28qsw_bus_stats_reset(ilps28qsw_bus_stats_t *stats);
+#endif /* ILPS28QSW_BUS_STATS */
+
+/*
+ * Recursive lock (e.g. RTOS recursive mutex) taken around read-modify-write
+ * and configuration operations: call these from task context only.
+ * Not locked, and callable from interrupt context:
+ * - single transaction reads (data_get, poll_snapshot_get, all_sources_get,
+ *   one_shot_fetch, ...);
+ * - FIFO drains: fifo_raw_data_get and the FIFO data getters,
+ *   fifo_ring_drain, fifo_service, fifo_ring_service, event_service and
+ *   qvar_stream_service. The caller serializes the drains among them and
+ *   with FIFO reconfiguration (e.g. a single ISR or consumer task).
+ * Also not locked: status_get (batched reads only) and one_shot_get, which
+ * waits between the locked start and the single transaction fetch.
+ * The platform read routine must be safe to call concurrently.
+ */
+typedef void (*ilps28qsw_lock_ptr)(void *);
+
+/*
+ * Optional driver data, built only with ILPS28QSW_PRIV_DATA defined: the
+ * define adds priv_data to stmdev_ctx_t (a shared MEMS_SHARED_TYPES
+ * definition must declare it too). Then every context must set priv_data,
+ * either to a zero initialized ilps28qsw_priv_t to enable the features
+ * below or to NULL: the driver always dereferences it. Without the define
+ * stmdev_ctx_t keeps its usual layout and the features are not available.
+ */
+typedef struct
+{
+  ilps28qsw_shadow_t shadow; /* read-modify-write run on cached registers */
+  ilps28qsw_async_read_ptr async_read;   /* non-blocking read, optional */
+  ilps28qsw_async_write_ptr async_write; /* non-blocking write, optional */
+  ilps28qsw_async_t *async;              /* operation in progress */
+  ilps28qsw_xfer_ptr xfer;               /* batched transfers, optional */
+  uint8_t fifo_burst;                    /* FIFO samples per read burst
+                                          * for this context (e.g. a bus
+                                          * with smaller transfers), up to
+                                          * the 128 FIFO entries; takes
+                                          * the place of the build time
+                                          * ILPS28QSW_FIFO_BURST_MAX,
+                                          * 0 keeps it */
+  ilps28qsw_lock_ptr lock;               /* shared context lock, optional */
+  ilps28qsw_lock_ptr unlock;
+  void *lock_handle;                     /* lock and unlock argument */
+#ifdef ILPS28QSW_BUS_STATS
+  ilps28qsw_bus_stats_t *stats;          /* bus instrumentation, optional */
+#endif /* ILPS28QSW_BUS_STATS */
+} ilps28qsw_priv_t;
+
 /**
   *@}
   *
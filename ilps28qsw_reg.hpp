@@ -0,0 +1,241 @@
+/*
+  ******************************************************************************
+  * @file    ilps28qsw_reg.hpp
+  * @author  Sensors Software Solution Team
+  * @brief   Header-only C++11 wrapper of the ilps28qsw_reg.c driver for
+  *          configurations with full scale and interleaved mode fixed at
+  *          build time.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef ILPS28QSW_REGS_HPP
+#define ILPS28QSW_REGS_HPP
+
+/* Includes ------------------------------------------------------------------*/
+#include "ilps28qsw_reg.h"
+
+/** @addtogroup ILPS28QSW
+  * @{
+  *
+  */
+
+/** @defgroup    Cpp_wrapper
+  * @brief       Ilps28qsw<FullScale, Interleaved, Transport> keeps the C
+  *              driver for configuration and reads the output registers and
+  *              FIFO directly through Transport, with decoders resolved at
+  *              compile time.
+  *
+  *              Transport is any class providing:
+  *                int32_t read(uint8_t reg, uint8_t *data, uint16_t len);
+  *                int32_t write(uint8_t reg, const uint8_t *data,
+  *                              uint16_t len);
+  *              with the same rules of the C platform routines
+  *              (MANDATORY: return 0 -> no Error).
+  * @{
+  *
+  */
+
+namespace ilps28qsw
+{
+
+enum class FullScale : uint8_t
+{
+  Fs1260hPa = ilps28qsw_md_t::ILPS28QSW_1260hPa,
+  Fs4060hPa = ilps28qsw_md_t::ILPS28QSW_4060hPa,
+};
+
+/* Sensitivity, on the 24 bit right aligned output */
+template <FullScale FS> struct Scale;
+
+template <> struct Scale<FullScale::Fs1260hPa>
+{
+  static constexpr float hpa_per_lsb()
+  {
+    return 1.0f / 4096.0f;
+  }
+  static constexpr int32_t lsb_per_hpa()
+  {
+    return 4096;
+  }
+};
+
+template <> struct Scale<FullScale::Fs4060hPa>
+{
+  static constexpr float hpa_per_lsb()
+  {
+    return 1.0f / 2048.0f;
+  }
+  static constexpr int32_t lsb_per_hpa()
+  {
+    return 2048;
+  }
+};
+
+/* FIFO or output register sample */
+struct Sample
+{
+  float hpa;    /* 0 for AH_QVAR samples */
+  int32_t qvar; /* AH_QVAR lsb, 0 for pressure samples */
+  bool is_qvar;
+};
+
+template <FullScale FS, bool Interleaved, class Transport>
+class Ilps28qsw
+{
+  public:
+#ifdef ILPS28QSW_PRIV_DATA
+    explicit Ilps28qsw(Transport &bus, void *priv_data = nullptr)
+      : bus_(bus)
+    {
+      ctx_.write_reg = &Ilps28qsw::write_cb;
+      ctx_.read_reg = &Ilps28qsw::read_cb;
+      ctx_.mdelay = nullptr;
+      ctx_.handle = &bus_;
+      ctx_.priv_data = priv_data;
+    }
+#else
+    explicit Ilps28qsw(Transport &bus)
+      : bus_(bus)
+    {
+      ctx_.write_reg = &Ilps28qsw::write_cb;
+      ctx_.read_reg = &Ilps28qsw::read_cb;
+      ctx_.mdelay = nullptr;
+      ctx_.handle = &bus_;
+    }
+#endif /* ILPS28QSW_PRIV_DATA */
+
+    /* C API access, for all the features not wrapped here */
+    stmdev_ctx_t *ctx()
+    {
+      return &ctx_;
+    }
+
+    /* conversion parameters with the build time settings */
+    static ilps28qsw_md_t md(uint8_t odr, uint8_t avg, uint8_t lpf)
+    {
+      ilps28qsw_md_t val;
+
+      val.fs = static_cast<decltype(val.fs)>(FS);
+      val.odr = static_cast<decltype(val.odr)>(odr);
+      val.avg = static_cast<decltype(val.avg)>(avg);
+      val.lpf = static_cast<decltype(val.lpf)>(lpf);
+      val.interleaved_mode = Interleaved ? 1U : 0U;
+
+      return val;
+    }
+
+    int32_t mode_set(uint8_t odr, uint8_t avg, uint8_t lpf)
+    {
+      ilps28qsw_md_t val = md(odr, avg, lpf);
+
+      return ilps28qsw_mode_set(&ctx_, &val);
+    }
+
+    /* 3 bytes little endian, as output registers and FIFO */
+    static Sample decode(const uint8_t *buff)
+    {
+      uint32_t u = static_cast<uint32_t>(buff[0]) |
+                   (static_cast<uint32_t>(buff[1]) << 8) |
+                   (static_cast<uint32_t>(buff[2]) << 16);
+      int32_t lsb = static_cast<int32_t>(u << 8) / 256;
+      bool qvar = Interleaved && ((buff[0] & 0x01U) != 0U);
+      Sample s;
+
+      s.is_qvar = qvar;
+      s.hpa = qvar ? 0.0f : static_cast<float>(lsb) * Scale<FS>::hpa_per_lsb();
+      s.qvar = qvar ? lsb : 0;
+
+      return s;
+    }
+
+    static constexpr float to_hpa(int32_t lsb)
+    {
+      return static_cast<float>(lsb) * Scale<FS>::hpa_per_lsb();
+    }
+
+    /* one burst on PRESS_OUT_XL .. PRESS_OUT_H */
+    int32_t data_get(Sample &val)
+    {
+      uint8_t buff[3];
+      int32_t ret;
+
+      ret = bus_.read(ILPS28QSW_PRESS_OUT_XL, buff, 3U);
+      if (ret == 0)
+      {
+        val = decode(buff);
+      }
+
+      return ret;
+    }
+
+    /* samp FIFO samples in bursts of ILPS28QSW_FIFO_DATA_CHUNK samples */
+    int32_t fifo_get(Sample *val, uint8_t samp)
+    {
+      uint8_t buff[ILPS28QSW_FIFO_DATA_CHUNK * ILPS28QSW_FIFO_SAMPLE_LEN];
+      uint8_t chunk;
+      uint8_t i = 0U;
+      uint8_t j;
+      int32_t ret = 0;
+
+      while ((i < samp) && (ret == 0))
+      {
+        chunk = static_cast<uint8_t>(samp - i);
+        if (chunk > ILPS28QSW_FIFO_DATA_CHUNK)
+        {
+          chunk = ILPS28QSW_FIFO_DATA_CHUNK;
+        }
+
+        ret = bus_.read(ILPS28QSW_FIFO_DATA_OUT_PRESS_XL, buff,
+                        static_cast<uint16_t>(chunk * ILPS28QSW_FIFO_SAMPLE_LEN));
+        for (j = 0U; (j < chunk) && (ret == 0); j++)
+        {
+          val[i + j] = decode(&buff[j * ILPS28QSW_FIFO_SAMPLE_LEN]);
+        }
+        i = static_cast<uint8_t>(i + chunk);
+      }
+
+      return ret;
+    }
+
+  private:
+    static int32_t write_cb(void *handle, uint8_t reg, const uint8_t *data,
+                            uint16_t len)
+    {
+      return static_cast<Transport *>(handle)->write(reg, data, len);
+    }
+
+    static int32_t read_cb(void *handle, uint8_t reg, uint8_t *data,
+                           uint16_t len)
+    {
+      return static_cast<Transport *>(handle)->read(reg, data, len);
+    }
+
+    Transport &bus_;
+    stmdev_ctx_t ctx_;
+};
+
+} /* namespace ilps28qsw */
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @}
+  *
+  */
+
+#endif /* ILPS28QSW_REGS_HPP */
@@ -0,0 +1,277 @@
+/*
+  ******************************************************************************
+  * @file    ilps28qsw_mock.c
+  * @author  Sensors Software Solution Team
+  * @brief   ILPS28QSW register file emulation for the host tests.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+#include "ilps28qsw_mock.h"
+#include <string.h>
+
+static int32_t mock_fail(ilps28qsw_mock_t *mock)
+{
+  uint32_t num = mock->rd + mock->wr + mock->xfer;
+
+  return ((mock->fail_at != 0U) && (num == mock->fail_at)) ?
+         mock->fail_ret : 0;
+}
+
+static uint8_t mock_reg_read(ilps28qsw_mock_t *mock, uint8_t addr)
+{
+  uint8_t val;
+
+  switch (addr)
+  {
+    case ILPS28QSW_FIFO_STATUS1:
+      val = mock->fifo_level;
+      break;
+    case ILPS28QSW_FIFO_STATUS2:
+      val = 0U;
+      if ((mock->reg[ILPS28QSW_FIFO_WTM] != 0U) &&
+          (mock->fifo_level >= (mock->reg[ILPS28QSW_FIFO_WTM] & 0x7FU)))
+      {
+        val |= 0x80U;
+      }
+      if (mock->fifo_level == ILPS28QSW_MOCK_FIFO_LEN)
+      {
+        val |= 0x20U;
+      }
+      break;
+    default:
+      val = mock->reg[addr];
+      break;
+  }
+
+  return val;
+}
+
+static void mock_reg_write(ilps28qsw_mock_t *mock, uint8_t addr, uint8_t val)
+{
+  if (addr == ILPS28QSW_CTRL_REG2)
+  {
+    if ((val & ILPS28QSW_CTRL_REG2_RELOAD) != 0U)
+    {
+      /* boot, swreset */
+      ilps28qsw_mock_por(mock);
+      return;
+    }
+    if ((val & 0x01U) != 0U)
+    {
+      /* oneshot: conversion done */
+      mock->reg[ILPS28QSW_PRESS_OUT_XL] = (uint8_t)mock->press;
+      mock->reg[ILPS28QSW_PRESS_OUT_L] = (uint8_t)(mock->press >> 8);
+      mock->reg[ILPS28QSW_PRESS_OUT_H] = (uint8_t)(mock->press >> 16);
+      mock->reg[ILPS28QSW_STATUS] |= 0x01U;
+      val &= 0xFEU;
+    }
+  }
+  if (((addr != ILPS28QSW_WHO_AM_I) && (addr < ILPS28QSW_INT_SOURCE)) ||
+      (addr == ILPS28QSW_ANALOGIC_HUB_DISABLE))
+  {
+    mock->reg[addr] = val;
+  }
+}
+
+/**
+  * @brief  Restore the power-on register values and empty the FIFO.
+  *
+  * @param  mock  emulated device.(ptr)
+  *
+  */
+void ilps28qsw_mock_por(ilps28qsw_mock_t *mock)
+{
+  (void)memset(mock->reg, 0, sizeof(mock->reg));
+  mock->reg[ILPS28QSW_WHO_AM_I] = ILPS28QSW_ID;
+  mock->reg[ILPS28QSW_CTRL_REG3] = 0x01U;
+  mock->fifo_head = 0U;
+  mock->fifo_level = 0U;
+  mock->fifo_out = 0U;
+}
+
+/**
+  * @brief  Reset the emulated device and bind it to a zeroed context.
+  *
+  * @param  mock  emulated device.(ptr)
+  * @param  ctx   communication interface handler.(ptr)
+  *
+  */
+void ilps28qsw_mock_init(ilps28qsw_mock_t *mock, stmdev_ctx_t *ctx)
+{
+  (void)memset(mock, 0, sizeof(*mock));
+  ilps28qsw_mock_por(mock);
+
+  (void)memset(ctx, 0, sizeof(*ctx));
+  ctx->read_reg = ilps28qsw_mock_read;
+  ctx->write_reg = ilps28qsw_mock_write;
+  ctx->handle = mock;
+}
+
+/**
+  * @brief  Clear the transaction counters.
+  *
+  * @param  mock  emulated device.(ptr)
+  *
+  */
+void ilps28qsw_mock_count_reset(ilps28qsw_mock_t *mock)
+{
+  mock->rd = 0U;
+  mock->wr = 0U;
+  mock->rd_bytes = 0U;
+  mock->wr_bytes = 0U;
+  mock->xfer = 0U;
+}
+
+/**
+  * @brief  Queue one 24 bit FIFO entry.
+  *
+  * @param  mock  emulated device.(ptr)
+  * @param  raw   FIFO entry.
+  * @retval       1 -> queued, 0 -> FIFO full
+  *
+  */
+uint8_t ilps28qsw_mock_push(ilps28qsw_mock_t *mock, uint32_t raw)
+{
+  uint8_t idx;
+
+  if (mock->fifo_level == ILPS28QSW_MOCK_FIFO_LEN)
+  {
+    return 0U;
+  }
+  idx = (uint8_t)((mock->fifo_head + mock->fifo_level) %
+                  ILPS28QSW_MOCK_FIFO_LEN);
+  mock->fifo[idx] = raw & 0x00FFFFFFU;
+  mock->fifo_level++;
+
+  return 1U;
+}
+
+static void mock_read(ilps28qsw_mock_t *mock, uint8_t reg, uint8_t *data,
+                      uint16_t len)
+{
+  uint16_t i;
+  uint8_t byte;
+
+  for (i = 0U; i < len; i++)
+  {
+    if (reg >= ILPS28QSW_FIFO_DATA_OUT_PRESS_XL)
+    {
+      /* FIFO output wraps on the 3 data registers */
+      byte = (uint8_t)((reg - ILPS28QSW_FIFO_DATA_OUT_PRESS_XL + i) % 3U);
+      if ((byte == 0U) && (mock->fifo_level > 0U))
+      {
+        mock->fifo_out = mock->fifo[mock->fifo_head];
+        mock->fifo_head = (uint8_t)((mock->fifo_head + 1U) %
+                                    ILPS28QSW_MOCK_FIFO_LEN);
+        mock->fifo_level--;
+      }
+      data[i] = (uint8_t)(mock->fifo_out >> (8U * byte));
+    }
+    else
+    {
+      data[i] = mock_reg_read(mock, (uint8_t)(reg + i));
+    }
+  }
+
+  if ((reg <= ILPS28QSW_PRESS_OUT_H) && ((reg + len) > ILPS28QSW_PRESS_OUT_H))
+  {
+    /* data read: clear the data available flags */
+    mock->reg[ILPS28QSW_STATUS] = 0U;
+  }
+}
+
+static void mock_write(ilps28qsw_mock_t *mock, uint8_t reg,
+                       const uint8_t *data, uint16_t len)
+{
+  uint16_t i;
+
+  for (i = 0U; i < len; i++)
+  {
+    mock_reg_write(mock, (uint8_t)(reg + i), data[i]);
+  }
+}
+
+/**
+  * @brief  Platform read routine (stmdev_read_ptr).
+  *
+  */
+int32_t ilps28qsw_mock_read(void *handle, uint8_t reg, uint8_t *data,
+                            uint16_t len)
+{
+  ilps28qsw_mock_t *mock = (ilps28qsw_mock_t *)handle;
+
+  mock->rd++;
+  mock->rd_bytes += len;
+  if (mock_fail(mock) != 0)
+  {
+    return mock->fail_ret;
+  }
+  mock_read(mock, reg, data, len);
+
+  return 0;
+}
+
+/**
+  * @brief  Platform write routine (stmdev_write_ptr).
+  *
+  */
+int32_t ilps28qsw_mock_write(void *handle, uint8_t reg, const uint8_t *data,
+                             uint16_t len)
+{
+  ilps28qsw_mock_t *mock = (ilps28qsw_mock_t *)handle;
+
+  mock->wr++;
+  mock->wr_bytes += len;
+  if (mock_fail(mock) != 0)
+  {
+    return mock->fail_ret;
+  }
+  mock_write(mock, reg, data, len);
+
+  return 0;
+}
+
+/**
+  * @brief  Platform batched transfer routine (ilps28qsw_xfer_ptr), counted
+  *         as one transaction.
+  *
+  */
+int32_t ilps28qsw_mock_xfer(void *handle, ilps28qsw_xfer_t *xfer, uint8_t n)
+{
+  ilps28qsw_mock_t *mock = (ilps28qsw_mock_t *)handle;
+  uint8_t i;
+
+  mock->xfer++;
+  if (mock_fail(mock) != 0)
+  {
+    return mock->fail_ret;
+  }
+  for (i = 0U; i < n; i++)
+  {
+    if (xfer[i].rd != 0U)
+    {
+      mock->rd_bytes += xfer[i].len;
+      mock_read(mock, xfer[i].reg, xfer[i].data, xfer[i].len);
+    }
+    else
+    {
+      mock->wr_bytes += xfer[i].len;
+      mock_write(mock, xfer[i].reg, xfer[i].data, xfer[i].len);
+    }
+  }
+
+  return 0;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,67 @@
+/*
+  ******************************************************************************
+  * @file    ilps28qsw_mock.h
+  * @author  Sensors Software Solution Team
+  * @brief   This file contains the host side register file emulation used
+  *          by the driver regression tests.
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+#ifndef ILPS28QSW_MOCK_H
+#define ILPS28QSW_MOCK_H
+
+#include "ilps28qsw_reg.h"
+
+/*
+ * Register map 0x00..0xFF with auto-increment, FIFO_STATUS1 returning the
+ * queue level and FIFO_DATA_OUT_PRESS_XL..H popping one 128 entries queue
+ * entry each 3 bytes. Writing boot or swreset in CTRL_REG2 restores the
+ * power-on values (self-clearing bits), writing oneshot completes the
+ * conversion at once.
+ */
+#define ILPS28QSW_MOCK_FIFO_LEN         128U
+
+typedef struct
+{
+  uint8_t reg[256];
+  uint32_t fifo[ILPS28QSW_MOCK_FIFO_LEN];
+  uint8_t fifo_head;
+  uint8_t fifo_level;
+  uint32_t fifo_out;      /* entry being read */
+  int32_t press;          /* next one-shot sample, 24 bit raw */
+  /* transaction counters */
+  uint32_t rd;
+  uint32_t wr;
+  uint32_t rd_bytes;
+  uint32_t wr_bytes;
+  uint32_t xfer;          /* batched calls */
+  /* error injection: returned by transaction number fail_at (1 based) */
+  uint32_t fail_at;
+  int32_t fail_ret;
+} ilps28qsw_mock_t;
+
+void ilps28qsw_mock_init(ilps28qsw_mock_t *mock, stmdev_ctx_t *ctx);
+void ilps28qsw_mock_por(ilps28qsw_mock_t *mock);
+void ilps28qsw_mock_count_reset(ilps28qsw_mock_t *mock);
+uint8_t ilps28qsw_mock_push(ilps28qsw_mock_t *mock, uint32_t raw);
+
+int32_t ilps28qsw_mock_read(void *handle, uint8_t reg, uint8_t *data,
+                            uint16_t len);
+int32_t ilps28qsw_mock_write(void *handle, uint8_t reg, const uint8_t *data,
+                             uint16_t len);
+int32_t ilps28qsw_mock_xfer(void *handle, ilps28qsw_xfer_t *xfer, uint8_t n);
+
+#endif /* ILPS28QSW_MOCK_H */
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -0,0 +1,463 @@
+/*
+  ******************************************************************************
+  * @file    ilps28qsw_test.c
+  * @author  Sensors Software Solution Team
+  * @brief   ILPS28QSW driver regression tests and bus cost benchmark on
+  *          the emulated register file.
+  *
+  *          ilps28qsw_test        run the regression tests
+  *          ilps28qsw_test bench  print the bus cost of the main APIs as
+  *                                CSV lines
+  ******************************************************************************
+  * @attention
+  *
+  * <h2><center>&copy; Copyright (c) 2023 STMicroelectronics.
+  * All rights reserved.</center></h2>
+  *
+  * This software component is licensed by ST under BSD 3-Clause license,
+  * the "License"; You may not use this file except in compliance with the
+  * License. You may obtain a copy of the License at:
+  *                        opensource.org/licenses/BSD-3-Clause
+  *
+  ******************************************************************************
+  */
+
+#include "ilps28qsw_mock.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+static ilps28qsw_mock_t mock;
+static stmdev_ctx_t dev_ctx;
+static ilps28qsw_priv_t dev_priv;
+static uint32_t failed;
+static uint32_t seed = 1U;
+
+static void check(int cond, const char *expr, int line)
+{
+  if (!cond)
+  {
+    (void)printf("FAIL line %d: %s\n", line, expr);
+    failed++;
+  }
+}
+
+static uint32_t lcg(void)
+{
+  seed = (seed * 1103515245U) + 12345U;
+
+  return seed >> 8;
+}
+
+/* fresh device and context, driver private data zeroed and attached */
+static void setup(void)
+{
+  ilps28qsw_mock_init(&mock, &dev_ctx);
+  (void)memset(&dev_priv, 0, sizeof(dev_priv));
+  dev_ctx.priv_data = &dev_priv;
+}
+
+static void md_default(ilps28qsw_md_t *md)
+{
+  (void)memset(md, 0, sizeof(*md));
+  md->fs = ILPS28QSW_1260hPa;
+  md->odr = ILPS28QSW_25Hz;
+  md->avg = ILPS28QSW_16_AVG;
+  md->lpf = ILPS28QSW_LPF_ODR_DIV_4;
+}
+
+static void test_shadow(void)
+{
+  ilps28qsw_int_mode_t int_mode;
+  ilps28qsw_md_t md;
+  ilps28qsw_md_t rd;
+
+  setup();
+  md_default(&md);
+
+  /* without a valid copy the setters read the device */
+  CHECK(ilps28qsw_mode_set(&dev_ctx, &md) == 0);
+  CHECK(mock.rd > 0U);
+
+  ilps28qsw_mock_count_reset(&mock);
+  CHECK(ilps28qsw_shadow_sync(&dev_ctx) == 0);
+  CHECK((mock.rd == 1U) && (mock.rd_bytes == 15U));
+  CHECK(dev_priv.shadow.valid == PROPERTY_ENABLE);
+
+  /* read-modify-write on the copy: writes only */
+  ilps28qsw_mock_count_reset(&mock);
+  md.odr = ILPS28QSW_100Hz;
+  CHECK(ilps28qsw_mode_set(&dev_ctx, &md) == 0);
+  int_mode.int_latched = PROPERTY_ENABLE;
+  CHECK(ilps28qsw_interrupt_mode_set(&dev_ctx, &int_mode) == 0);
+  CHECK((mock.rd == 0U) && (mock.wr > 0U));
+  CHECK(memcmp(dev_priv.shadow.reg, &mock.reg[ILPS28QSW_INTERRUPT_CFG],
+               15) == 0);
+
+  /* getters still read the device */
+  CHECK(ilps28qsw_mode_get(&dev_ctx, &rd) == 0);
+  CHECK((rd.odr == ILPS28QSW_100Hz) && (rd.avg == md.avg) &&
+        (rd.lpf == md.lpf));
+
+  /* software reset drops the copy */
+  CHECK(ilps28qsw_init_set(&dev_ctx, ILPS28QSW_RESET) == 0);
+  CHECK(dev_priv.shadow.valid == PROPERTY_DISABLE);
+}
+
+static void test_batching(void)
+{
+  ilps28qsw_profile_t prof;
+  ilps28qsw_plan_t plan;
+  ilps28qsw_stat_t status;
+  ilps28qsw_md_t rd;
+
+  setup();
+  dev_priv.xfer = ilps28qsw_mock_xfer;
+
+  ilps28qsw_mock_count_reset(&mock);
+  CHECK(ilps28qsw_status_get(&dev_ctx, &status) == 0);
+  CHECK((mock.xfer == 1U) && (mock.rd == 0U) && (mock.wr == 0U));
+
+  (void)memset(&prof, 0, sizeof(prof));
+  md_default(&prof.md);
+  prof.fifo.operation = ILPS28QSW_STREAM;
+  prof.fifo.watermark = 16U;
+  ilps28qsw_plan_build(&prof, &plan);
+  CHECK((plan.len > 1U) && (plan.len <= ILPS28QSW_PLAN_MAX));
+
+  ilps28qsw_mock_count_reset(&mock);
+  CHECK(ilps28qsw_plan_apply(&dev_ctx, &plan) == 0);
+  /* CTRL_REG3 auto-increment check, then all the writes in one batch */
+  CHECK((mock.xfer == 1U) && (mock.rd == 1U) && (mock.wr == 0U));
+  CHECK(mock.reg[ILPS28QSW_FIFO_WTM] == 16U);
+
+  dev_priv.xfer = NULL;
+  CHECK(ilps28qsw_mode_get(&dev_ctx, &rd) == 0);
+  CHECK((rd.odr == prof.md.odr) && (rd.avg == prof.md.avg));
+
+  /* batch error reaches the caller */
+  dev_priv.xfer = ilps28qsw_mock_xfer;
+  ilps28qsw_mock_count_reset(&mock);
+  mock.fail_at = 1U;
+  mock.fail_ret = -7;
+  CHECK(ilps28qsw_plan_apply(&dev_ctx, &plan) == -7);
+  mock.fail_at = 0U;
+}
+
+static void test_resume(void)
+{
+  static const uint8_t keep[15] =
+  {
+    ILPS28QSW_INTERRUPT_CFG_KEEP, 0xFFU, 0xFFU, 0xFFU, 0x00U, 0xFFU,
+    ILPS28QSW_CTRL_REG2_KEEP, 0xFFU, 0x00U, 0xFFU, 0xFFU, 0x00U, 0x00U,
+    0x00U, 0xFFU,
+  };
+  ilps28qsw_fifo_md_t fifo_md;
+  ilps28qsw_cfg_snap_t snap;
+  ilps28qsw_md_t md;
+  uint8_t i;
+
+  setup();
+  md_default(&md);
+  md.interleaved_mode = PROPERTY_ENABLE;
+  CHECK(ilps28qsw_mode_set(&dev_ctx, &md) == 0);
+  fifo_md.operation = ILPS28QSW_STREAM;
+  fifo_md.watermark = 20U;
+  CHECK(ilps28qsw_fifo_mode_set(&dev_ctx, &fifo_md) == 0);
+  CHECK(ilps28qsw_shadow_sync(&dev_ctx) == 0);
+  CHECK(ilps28qsw_cfg_snap_save(&dev_ctx, &snap) == 0);
+
+  /* retained configuration: one read, no write */
+  ilps28qsw_mock_count_reset(&mock);
+  CHECK(ilps28qsw_resume(&dev_ctx, &snap) == 0);
+  CHECK((mock.rd == 1U) && (mock.wr == 0U));
+
+  /* power lost: everything rewritten, shadow refreshed */
+  ilps28qsw_mock_por(&mock);
+  CHECK(ilps28qsw_resume(&dev_ctx, &snap) == 0);
+  CHECK(mock.wr > 0U);
+  for (i = 0U; i < 15U; i++)
+  {
+    CHECK(((mock.reg[ILPS28QSW_INTERRUPT_CFG + i] ^ snap.reg[i]) &
+           keep[i]) == 0U);
+  }
+  CHECK(dev_priv.shadow.valid == PROPERTY_ENABLE);
+  CHECK(memcmp(dev_priv.shadow.reg, &mock.reg[ILPS28QSW_INTERRUPT_CFG],
+               15) == 0);
+
+  /* other device on the bus: nothing written */
+  mock.reg[ILPS28QSW_WHO_AM_I] = 0x00U;
+  ilps28qsw_mock_count_reset(&mock);
+  CHECK(ilps28qsw_resume(&dev_ctx, &snap) != 0);
+  CHECK(mock.wr == 0U);
+}
+
+static void codec_run(uint8_t interleaved, uint16_t samp)
+{
+  static uint8_t raw[3U * 256U];
+  static uint8_t dec[3U * 256U];
+  static uint8_t out[ILPS28QSW_TLM_HDR_LEN + (ILPS28QSW_TLM_SAMPLE_MAX * 256U)];
+  ilps28qsw_tlm_t enc_st;
+  ilps28qsw_tlm_t dec_st;
+  ilps28qsw_md_t md;
+  ilps28qsw_md_t hdr_md;
+  uint16_t tot = 0U;
+  uint16_t pos = 0U;
+  uint16_t got = 0U;
+  uint16_t num;
+  uint16_t used;
+  int32_t val = 0x100000;
+  uint32_t u;
+  uint16_t i;
+
+  md_default(&md);
+  md.interleaved_mode = interleaved;
+  for (i = 0U; i < samp; i++)
+  {
+    val += (int32_t)(lcg() % 2001U) - 1000;
+    if (i == 5U)
+    {
+      val = -8388608;
+    }
+    else if (i == 6U)
+    {
+      val = 8388607;
+    }
+    u = (uint32_t)val & 0x00FFFFFEU;
+    if ((interleaved != 0U) && ((i & 1U) != 0U))
+    {
+      u = (lcg() & 0x00FFFFFEU) | 1U;
+    }
+    raw[3U * i] = (uint8_t)u;
+    raw[(3U * i) + 1U] = (uint8_t)(u >> 8);
+    raw[(3U * i) + 2U] = (uint8_t)(u >> 16);
+  }
+
+  ilps28qsw_tlm_enc_init(&enc_st, &md, out);
+  tot = ILPS28QSW_TLM_HDR_LEN;
+  for (i = 0U; i < samp; i += num)
+  {
+    /* small output windows to exercise partial encoding */
+    num = ilps28qsw_tlm_encode(&enc_st, &raw[3U * i], samp - i, &out[tot],
+                               9U, &used);
+    tot += used;
+  }
+
+  CHECK(ilps28qsw_tlm_dec_init(&dec_st, out, &hdr_md) == 0);
+  CHECK((hdr_md.odr == md.odr) && (hdr_md.avg == md.avg) &&
+        (hdr_md.interleaved_mode == interleaved));
+  pos = ILPS28QSW_TLM_HDR_LEN;
+  while ((got < samp) && (pos < tot))
+  {
+    num = ((uint16_t)(tot - pos) > 5U) ? 5U : (uint16_t)(tot - pos);
+    CHECK(ilps28qsw_tlm_decode(&dec_st, &out[pos], num, &dec[3U * got],
+                               samp - got, &i, &used) == 0);
+    if (used == 0U)
+    {
+      break;
+    }
+    pos += used;
+    got += i;
+  }
+  CHECK((got == samp) && (pos == tot));
+  CHECK(memcmp(raw, dec, 3U * samp) == 0);
+}
+
+static void test_codec(void)
+{
+  const uint8_t hdr[ILPS28QSW_TLM_HDR_LEN] = { ILPS28QSW_TLM_VERSION << 4,
+                                               0x04U, 0x00U
+                                             };
+  const uint8_t overlong[] = { 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0x01U };
+  ilps28qsw_tlm_t tlm;
+  ilps28qsw_md_t md;
+  uint8_t buff[12];
+  uint16_t num;
+  uint16_t used;
+
+  codec_run(0U, 256U);
+  codec_run(1U, 255U);
+  codec_run(0U, 1U);
+
+  CHECK(ilps28qsw_tlm_dec_init(&tlm, hdr, &md) == 0);
+  CHECK(ilps28qsw_tlm_decode(&tlm, overlong, sizeof(overlong), buff, 4U,
+                             &num, &used) != 0);
+  CHECK(num == 0U);
+}
+
+static void test_ring_drain(void)
+{
+  static ilps28qsw_ring_t ring;
+  ilps28qsw_fifo_sample_t out[8];
+  ilps28qsw_md_t md;
+  uint8_t stored;
+  uint32_t i;
+
+  setup();
+  md_default(&md);
+  ilps28qsw_ring_init(&ring);
+  ring.head = (uint16_t)(ILPS28QSW_RING_SIZE - 3U);
+  ring.tail = ring.head;
+  for (i = 0U; i < 8U; i++)
+  {
+    (void)ilps28qsw_mock_push(&mock, i << 8);
+  }
+
+  /* wrapped drain, second segment read fails: first one is kept */
+  ilps28qsw_mock_count_reset(&mock);
+  mock.fail_at = 2U;
+  mock.fail_ret = -3;
+  CHECK(ilps28qsw_fifo_ring_drain(&dev_ctx, 8U, &md, &ring, &stored) == -3);
+  mock.fail_at = 0U;
+  CHECK((stored == 3U) && (ilps28qsw_ring_count(&ring) == 3U));
+  CHECK(ilps28qsw_ring_pop(&ring, out, 8U) == 3U);
+  for (i = 0U; i < 3U; i++)
+  {
+    CHECK(out[i] == (i << 8));
+  }
+}
+
+static void test_one_shot(void)
+{
+  ilps28qsw_data_t data;
+  ilps28qsw_md_t md;
+  uint8_t ready;
+
+  setup();
+  md_default(&md);
+  md.odr = ILPS28QSW_ONE_SHOT;
+  mock.press = 0x400000;
+  CHECK(ilps28qsw_one_shot_get(&dev_ctx, &md, &data, &ready) == 0);
+  CHECK((ready == PROPERTY_ENABLE) && (data.pressure.raw == 0x40000000));
+
+  /* not ready is not an error */
+  mock.reg[ILPS28QSW_STATUS] = 0U;
+  CHECK(ilps28qsw_one_shot_fetch(&dev_ctx, &md, &data, &ready) == 0);
+  CHECK(ready == PROPERTY_DISABLE);
+
+  /* bus error is reported as is */
+  ilps28qsw_mock_count_reset(&mock);
+  mock.fail_at = 1U;
+  mock.fail_ret = -5;
+  CHECK(ilps28qsw_one_shot_fetch(&dev_ctx, &md, &data, &ready) == -5);
+  CHECK(ready == PROPERTY_DISABLE);
+  mock.fail_at = 0U;
+}
+
+static void bench_line(const char *api, uint32_t arg, uint32_t calls,
+                       clock_t start)
+{
+  double sec = (double)(clock() - start) / (double)CLOCKS_PER_SEC;
+
+  (void)printf("%s,%lu,%lu,%lu,%lu,%lu,%.3f\n", api, (unsigned long)arg,
+               (unsigned long)(mock.rd + mock.wr + mock.xfer) / calls,
+               (unsigned long)(mock.rd_bytes + mock.wr_bytes) / calls,
+               (unsigned long)mock.rd / calls, (unsigned long)mock.wr / calls,
+               (sec * 1.0e9) / (double)calls);
+}
+
+/* bus cost per call: transactions, bytes, reads, writes and host time */
+static void bench(void)
+{
+  static ilps28qsw_fifo_sample_t samp[ILPS28QSW_MOCK_FIFO_LEN];
+  const uint32_t calls = 10000U;
+  ilps28qsw_fifo_srv_t srv;
+  ilps28qsw_data_t data;
+  ilps28qsw_stat_t status;
+  ilps28qsw_md_t md;
+  clock_t start;
+  uint32_t wtm;
+  uint32_t i;
+  uint32_t j;
+
+  (void)printf("api,arg,transactions,bytes,reads,writes,ns_per_call\n");
+
+  setup();
+  md_default(&md);
+  ilps28qsw_mock_count_reset(&mock);
+  start = clock();
+  for (i = 0U; i < calls; i++)
+  {
+    md.odr = ((i & 1U) != 0U) ? ILPS28QSW_25Hz : ILPS28QSW_50Hz;
+    (void)ilps28qsw_mode_set(&dev_ctx, &md);
+  }
+  bench_line("mode_set", 0U, calls, start);
+
+  (void)ilps28qsw_shadow_sync(&dev_ctx);
+  ilps28qsw_mock_count_reset(&mock);
+  start = clock();
+  for (i = 0U; i < calls; i++)
+  {
+    md.odr = ((i & 1U) != 0U) ? ILPS28QSW_25Hz : ILPS28QSW_50Hz;
+    (void)ilps28qsw_mode_set(&dev_ctx, &md);
+  }
+  bench_line("mode_set_shadow", 0U, calls, start);
+
+  ilps28qsw_mock_count_reset(&mock);
+  start = clock();
+  for (i = 0U; i < calls; i++)
+  {
+    (void)ilps28qsw_data_get(&dev_ctx, &md, &data);
+  }
+  bench_line("data_get", 0U, calls, start);
+
+  ilps28qsw_mock_count_reset(&mock);
+  start = clock();
+  for (i = 0U; i < calls; i++)
+  {
+    (void)ilps28qsw_status_get(&dev_ctx, &status);
+  }
+  bench_line("status_get", 0U, calls, start);
+
+  dev_priv.xfer = ilps28qsw_mock_xfer;
+  ilps28qsw_mock_count_reset(&mock);
+  start = clock();
+  for (i = 0U; i < calls; i++)
+  {
+    (void)ilps28qsw_status_get(&dev_ctx, &status);
+  }
+  bench_line("status_get_xfer", 0U, calls, start);
+  dev_priv.xfer = NULL;
+
+  /* FIFO drain at each watermark, arg = samples per drain */
+  for (wtm = 1U; wtm <= ILPS28QSW_MOCK_FIFO_LEN; wtm++)
+  {
+    ilps28qsw_mock_count_reset(&mock);
+    start = clock();
+    for (i = 0U; i < 100U; i++)
+    {
+      for (j = 0U; j < wtm; j++)
+      {
+        (void)ilps28qsw_mock_push(&mock, j << 8);
+      }
+      (void)ilps28qsw_fifo_service(&dev_ctx, &md, samp,
+                                   (uint8_t)ILPS28QSW_MOCK_FIFO_LEN, &srv);
+    }
+    bench_line("fifo_service", wtm, 100U, start);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  if ((argc > 1) && (strcmp(argv[1], "bench") == 0))
+  {
+    bench();
+    return 0;
+  }
+
+  test_shadow();
+  test_batching();
+  test_resume();
+  test_codec();
+  test_ring_drain();
+  test_one_shot();
+
+  (void)printf("%s: %lu failed\n", (failed == 0U) ? "PASS" : "FAIL",
+               (unsigned long)failed);
+
+  return (failed == 0U) ? 0 : 1;
+}
+
+/************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/